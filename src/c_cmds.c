@@ -54,6 +54,7 @@
 #include "i_system.h"
 #include "m_menu.h"
 #include "m_misc.h"
+#include "m_profile.h"
 #include "m_random.h"
 #include "p_inter.h"
 #include "p_local.h"
@@ -112,8 +113,10 @@ extern int              am_thingcolor;
 extern int              am_tswallcolor;
 extern int              am_wallcolor;
 extern dboolean         autoload;
+extern int              cachesize;
 extern dboolean         centerweapon;
 extern dboolean         con_obituaries;
+extern int              con_scrollback;
 extern dboolean         con_timestamps;
 extern int              episode;
 extern int              expansion;
@@ -129,6 +132,7 @@ extern char             *language;
 extern dboolean         messages;
 extern float            m_acceleration;
 extern dboolean         m_doubleclick_use;
+extern dboolean         m_latelatch;
 extern dboolean         m_novertical;
 extern int              m_sensitivity;
 extern int              m_threshold;
@@ -166,6 +170,7 @@ extern dboolean         r_rockettrails;
 extern int              r_screensize;
 extern dboolean         r_shadows;
 extern int              r_shakescreen;
+extern dboolean         r_showrenderstats;
 extern dboolean         r_translucency;
 extern int              s_musicvolume;
 extern dboolean         s_randommusic;
@@ -218,6 +223,7 @@ extern int              vid_display;
 extern char             *vid_driver;
 #endif
 extern dboolean         vid_fullscreen;
+extern int              vid_maxfps;
 extern int              vid_motionblur;
 extern char             *vid_scaleapi;
 extern char             *vid_scalefilter;
@@ -336,6 +342,7 @@ static dboolean cheat_func1(char *, char *, char *, char *);
 static dboolean game_func1(char *, char *, char *, char *);
 static dboolean null_func1(char *, char *, char *, char *);
 
+static void benchmaps_cmd_func2(char *, char *, char *, char *);
 static void bindlist_cmd_func2(char *, char *, char *, char *);
 static void clear_cmd_func2(char *, char *, char *, char *);
 static void cmdlist_cmd_func2(char *, char *, char *, char *);
@@ -345,6 +352,7 @@ static void endgame_cmd_func2(char *, char *, char *, char *);
 static void exitmap_cmd_func2(char *, char *, char *, char *);
 static dboolean fastmonsters_cmd_func1(char *, char *, char *, char *);
 static void fastmonsters_cmd_func2(char *, char *, char *, char *);
+static void frametimes_cmd_func2(char *, char *, char *, char *);
 static dboolean give_cmd_func1(char *, char *, char *, char *);
 static void give_cmd_func2(char *, char *, char *, char *);
 static dboolean god_cmd_func1(char *, char *, char *, char *);
@@ -357,6 +365,8 @@ static dboolean map_cmd_func1(char *, char *, char *, char *);
 static void map_cmd_func2(char *, char *, char *, char *);
 static void maplist_cmd_func2(char *, char *, char *, char *);
 static void mapstats_cmd_func2(char *, char *, char *, char *);
+static void memstats_cmd_func2(char *, char *, char *, char *);
+static void mouselatency_cmd_func2(char *, char *, char *, char *);
 static void noclip_cmd_func2(char *, char *, char *, char *);
 static void nomonsters_cmd_func2(char *, char *, char *, char *);
 static void notarget_cmd_func2(char *, char *, char *, char *);
@@ -364,7 +374,9 @@ static void pistolstart_cmd_func2(char *, char *, char *, char *);
 static dboolean play_cmd_func1(char *, char *, char *, char *);
 static void play_cmd_func2(char *, char *, char *, char *);
 static void playerstats_cmd_func2(char *, char *, char *, char *);
+static void profile_cmd_func2(char *, char *, char *, char *);
 static void quit_cmd_func2(char *, char *, char *, char *);
+static void renderstats_cmd_func2(char *, char *, char *, char *);
 static void reset_cmd_func2(char *, char *, char *, char *);
 static void resetall_cmd_func2(char *, char *, char *, char *);
 static void respawnitems_cmd_func2(char *, char *, char *, char *);
@@ -399,6 +411,7 @@ static void player_cvars_func2(char *, char *, char *, char *);
 static void alwaysrun_cvar_func2(char *, char *, char *, char *);
 static dboolean r_blood_cvar_func1(char *, char *, char *, char *);
 static void r_blood_cvar_func2(char *, char *, char *, char *);
+static void r_bloodsplats_max_cvar_func2(char *, char *, char *, char *);
 static dboolean r_detail_cvar_func1(char *, char *, char *, char *);
 static void r_detail_cvar_func2(char *, char *, char *, char *);
 static dboolean r_gamma_cvar_func1(char *, char *, char *, char *);
@@ -531,10 +544,14 @@ consolecmd_t consolecmds[] =
         "The player's armor."),
     CVAR_BOOL(autoload, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles automatically loading the last savegame after the\nplayer dies."),
+    CMD(benchmaps, "", null_func1, benchmaps_cmd_func2, 1, "[<i>filename</i><b>.csv</b>]",
+        "Loads every map in turn, and saves how long each part of\nloading them took to a file."),
     CMD(bind, "", null_func1, C_Bind, 2, BINDCMDFORMAT,
         "Binds an <i>action</i> to a <i>control</i>."),
     CMD(bindlist, "", null_func1, bindlist_cmd_func2, 0, "",
         "Shows a list of all bound controls."),
+    CVAR_INT(cachesize, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOALIAS,
+        "The maximum amount of memory, in megabytes, used to cache\nlumps and textures (<b>0</b> for no limit)."),
     CVAR_BOOL(centerweapon, centreweapon, bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles the centering of the player's weapon when firing."),
     CMD(clear, "", null_func1, clear_cmd_func2, 0, "",
@@ -543,6 +560,8 @@ consolecmd_t consolecmds[] =
         "Shows a list of console commands."),
     CVAR_BOOL(con_obituaries, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles obituaries in the console when monsters are killed."),
+    CVAR_INT(con_scrollback, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOALIAS,
+        "The number of lines kept in the console's scrollback (<b>100</b> to\n<b>65,536</b>)."),
     CVAR_BOOL(con_timestamps, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles timestamps in the console next to player messages."),
     CMD(condump, "", null_func1, condump_cmd_func2, 1, "[<i>filename</i><b>.txt</b>]",
@@ -561,6 +580,8 @@ consolecmd_t consolecmds[] =
         "The color behind the player's face in the status bar."),
     CMD(fastmonsters, "", game_func1, fastmonsters_cmd_func2, 1, "[<b>on</b>|<b>off</b>]",
         "Toggles fast monsters."),
+    CMD(frametimes, "", null_func1, frametimes_cmd_func2, 1, "[<i>filename</i><b>.csv</b>]",
+        "Shows statistics about the time taken by the most recent\nframes, or saves them to a file."),
     CVAR_TIME(gametime, "", null_func1, time_cvars_func2,
         "The amount of time since <i><b>"PACKAGE_NAME"</b></i> started."),
     CMD(give, "", give_cmd_func1, give_cmd_func2, 1, GIVECMDSHORTFORMAT,
@@ -612,6 +633,8 @@ consolecmd_t consolecmds[] =
         "The amount the mouse accelerates."),
     CVAR_BOOL(m_doubleclick_use, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles double-clicking a mouse button for the <b>+use</b> action."),
+    CVAR_BOOL(m_latelatch, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
+        "Toggles turning the player's view with the mouse just before\neach frame is rendered."),
     CVAR_BOOL(m_novertical, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles no vertical movement of the mouse."),
     CVAR_INT(m_sensitivity, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOALIAS,
@@ -624,8 +647,12 @@ consolecmd_t consolecmds[] =
         "Shows a list of the available maps."),
     CMD(mapstats, "", game_func1, mapstats_cmd_func2, 0, "",
         "Shows statistics about the current map."),
+    CMD(memstats, "", null_func1, memstats_cmd_func2, 1, "[<i>seconds</i>]",
+        "Shows how much memory is being used, or shows a summary\nevery <i>seconds</i> seconds (<b>0</b> to stop)."),
     CVAR_BOOL(messages, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
         "Toggles player messages."),
+    CMD(mouselatency, "", null_func1, mouselatency_cmd_func2, 0, "",
+        "Starts or stops measuring how long it takes for movement\nof the mouse to be shown."),
     CVAR_INT(movebob, "", int_cvars_func1, int_cvars_func2, CF_PERCENT, NOALIAS,
         "The amount the player's view bobs up and down when they move."),
     CMD_CHEAT(mumu, 0),
@@ -643,6 +670,8 @@ consolecmd_t consolecmds[] =
         "The name of the player used in player messages."),
     CMD(playerstats, "", null_func1, playerstats_cmd_func2, 0, "",
         "Shows statistics about the player."),
+    CMD(profile, "", null_func1, profile_cmd_func2, 1, "[<b>on</b>|<b>off</b>]",
+        "Toggles the frame profiler, or shows a summary of the most\nrecently profiled frames."),
     CMD(quit, exit, null_func1, quit_cmd_func2, 0, "",
         "Quits <i><b>"PACKAGE_NAME"</b></i>."),
     CVAR_BOOL(r_althud, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
@@ -651,7 +680,7 @@ consolecmd_t consolecmds[] =
         "The intensity of the screen's red haze when the player has the\nberserk power-up and their fists selected (<b>0</b> to <b>8</b>)."),
     CVAR_INT(r_blood, "", r_blood_cvar_func1, r_blood_cvar_func2, CF_NONE, BLOODALIAS,
         "The colors of the blood of the player and monsters (<b>all</b>, <b>none</b> or\n<b>red</b>)."),
-    CVAR_INT(r_bloodsplats_max, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOALIAS,
+    CVAR_INT(r_bloodsplats_max, "", int_cvars_func1, r_bloodsplats_max_cvar_func2, CF_NONE, NOALIAS,
         "The maximum number of blood splats allowed in a map (<b>0</b> to\n<b>1,048,576</b>)."),
     CVAR_INT(r_bloodsplats_total, "", int_cvars_func1, int_cvars_func2, CF_READONLY, NOALIAS,
         "The total number of blood splats in the current map."),
@@ -709,8 +738,12 @@ consolecmd_t consolecmds[] =
         "Toggles sprites casting shadows."),
     CVAR_INT(r_shakescreen, "", int_cvars_func1, int_cvars_func2, CF_PERCENT, NOALIAS,
         "The amount the screen shakes when the player is attacked."),
+    CVAR_BOOL(r_showrenderstats, "", bool_cvars_func1, bool_cvars_func2, BOOLALIAS,
+        "Toggles showing how much the renderer is drawing each\nframe."),
     CVAR_BOOL(r_translucency, "", bool_cvars_func1, r_translucency_cvar_func2, BOOLALIAS,
         "Toggles the translucency of sprites and textures."),
+    CMD(renderstats, "", null_func1, renderstats_cmd_func2, 0, "",
+        "Shows statistics about the renderer's workload."),
     CMD(reset, "", null_func1, reset_cmd_func2, 1, RESETCMDFORMAT,
         "Resets a console variable to its default value."),
     CMD(resetall, "", null_func1, resetall_cmd_func2, 0, "",
@@ -763,6 +796,8 @@ consolecmd_t consolecmds[] =
 #endif
     CVAR_BOOL(vid_fullscreen, "", bool_cvars_func1, vid_fullscreen_cvar_func2, BOOLALIAS,
         "Toggles between fullscreen and a window."),
+    CVAR_INT(vid_maxfps, "", int_cvars_func1, int_cvars_func2, CF_NONE, NOALIAS,
+        "The maximum framerate when <b>vid_capfps</b> is <b>off</b> (<b>0</b>\nfor no limit)."),
     CVAR_INT(vid_motionblur, "", int_cvars_func1, int_cvars_func2, CF_PERCENT, NOALIAS,
         "The amount of motion blur when the player turns quickly."),
     CVAR_STR(vid_scaleapi, "", vid_scaleapi_cvar_func1, vid_scaleapi_cvar_func2, CF_NONE,
@@ -787,18 +822,148 @@ consolecmd_t consolecmds[] =
     { "", "", null_func1, NULL, 0, 0, CF_NONE, NULL, 0, 0, 0, "", "" }
 };
 
-static int C_GetIndex(const char *cmd)
+//
+// Console command index
+// consolecmds[] is hashed by name and alternate name for exact lookups, and
+// sorted by name for prefix searches such as autocomplete and wildcards.
+//
+#define CMDHASHSIZE     1024
+
+typedef struct
 {
-    int i = 0;
+    char                *key;
+    int                 index;
+} cmdhashentry_t;
 
-    while (*consolecmds[i].name)
+static cmdhashentry_t   cmdhash[CMDHASHSIZE];
+static int              sortedcmds[CMDHASHSIZE];
+static int              numcmds = -1;
+
+static unsigned int C_HashCmd(const char *name)
+{
+    return (M_StringHash(name) & (CMDHASHSIZE - 1));
+}
+
+static void C_AddToCmdHash(char *key, int index)
+{
+    unsigned int        slot = C_HashCmd(key);
+
+    // entries without an alternate name have "" as theirs
+    if (!*key || M_StringCompare(key, EMPTYVALUE))
+        return;
+
+    while (cmdhash[slot].key)
     {
-        if (M_StringCompare(cmd, consolecmds[i].name))
-            break;
-        ++i;
+        // the first entry with a name is the one that is used
+        if (M_StringCompare(key, cmdhash[slot].key))
+            return;
+        slot = (slot + 1) & (CMDHASHSIZE - 1);
+    }
+
+    cmdhash[slot].key = key;
+    cmdhash[slot].index = index;
+}
+
+static int C_CompareCmds(const void *a, const void *b)
+{
+    return strcasecmp(consolecmds[*(int *)a].name, consolecmds[*(int *)b].name);
+}
+
+//
+// C_InitCmdIndex
+// Called once from C_Init, or the first time a command is looked up.
+//
+void C_InitCmdIndex(void)
+{
+    int i;
+
+    if (numcmds >= 0)
+        return;
+
+    for (numcmds = 0; *consolecmds[numcmds].name; ++numcmds);
+
+    // names and alternate names must fill no more than half of the table
+    if (numcmds * 4 > CMDHASHSIZE)
+        I_Error("C_InitCmdIndex: Too many console commands");
+
+    for (i = 0; i < numcmds; ++i)
+    {
+        sortedcmds[i] = i;
+        C_AddToCmdHash(consolecmds[i].name, i);
+    }
+
+    for (i = 0; i < numcmds; ++i)
+        C_AddToCmdHash(consolecmds[i].alternate, i);
+
+    qsort(sortedcmds, numcmds, sizeof(*sortedcmds), C_CompareCmds);
+}
+
+//
+// C_GetIndex
+// Returns the index in consolecmds[] of the command with the given name or
+// alternate name, or of the empty entry at the end if there is none.
+//
+int C_GetIndex(const char *cmd)
+{
+    unsigned int        slot;
+
+    C_InitCmdIndex();
+
+    for (slot = C_HashCmd(cmd); cmdhash[slot].key; slot = (slot + 1) & (CMDHASHSIZE - 1))
+        if (M_StringCompare(cmd, cmdhash[slot].key))
+            return cmdhash[slot].index;
+
+    return numcmds;
+}
+
+//
+// C_GetSortedIndex
+// Returns the index in consolecmds[] of the command at the given position
+// when they are sorted by name, or of the empty entry at the end.
+//
+int C_GetSortedIndex(int position)
+{
+    C_InitCmdIndex();
+
+    return (position >= 0 && position < numcmds ? sortedcmds[position] : numcmds);
+}
+
+//
+// C_GetFirstWithPrefix
+// Returns the first position in the sorted commands whose name starts with
+// the given prefix, ignoring case. Any others follow it.
+//
+int C_GetFirstWithPrefix(const char *prefix)
+{
+    int low = 0;
+    int high;
+
+    C_InitCmdIndex();
+
+    high = numcmds;
+
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+
+        if (strcasecmp(consolecmds[sortedcmds[mid]].name, prefix) < 0)
+            low = mid + 1;
+        else
+            high = mid;
     }
 
-    return i;
+    return low;
+}
+
+//
+// C_HasPrefix
+// Returns true if the name of the command at the given sorted position
+// starts with prefix, ignoring case.
+//
+dboolean C_HasPrefix(int position, const char *prefix)
+{
+    return (position >= 0 && position < numcmds
+        && !strncasecmp(consolecmds[sortedcmds[position]].name, prefix, strlen(prefix)));
 }
 
 static dboolean cheat_func1(char *cmd, char *parm1, char *parm2, char *parm3)
@@ -1030,6 +1195,39 @@ void C_Bind(char *cmd, char *parm1, char *parm2, char *parm3)
     }
 }
 
+//
+// benchmaps cmd
+//
+static void benchmaps_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    char            filename[MAX_PATH];
+    const char      *appdatafolder = M_GetAppDataFolder();
+    int             count;
+    const int       oldepisode = gameepisode;
+    const int       oldmap = gamemap;
+    const skill_t   oldskill = gameskill;
+    const dboolean  ingame = (gamestate == GS_LEVEL);
+
+    M_MakeDirectory(appdatafolder);
+    M_snprintf(filename, sizeof(filename), "%s"DIR_SEPARATOR_S"%s", appdatafolder,
+        (*parm1 ? parm1 : "benchmaps.csv"));
+
+    if ((count = G_BenchmarkMaps(filename)) < 0)
+    {
+        C_Warning("<b>%s</b> couldn't be saved.", filename);
+        return;
+    }
+
+    C_Output("Loaded <b>%s</b> map%s and saved how long each took to the file <b>%s</b>.",
+        commify(count), (count == 1 ? "" : "s"), filename);
+
+    // the game can't continue from where it was, so start the map again
+    if (ingame)
+        G_DeferredInitNew(oldskill, oldepisode, oldmap);
+    else
+        M_EndingGame();
+}
+
 //
 // bindlist cmd
 //
@@ -1078,24 +1276,43 @@ static void bindlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
 //
 // clear cmd
 //
-extern int      consolestrings;
-
 static void clear_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
 {
-    consolestrings = 0;
+    C_ClearConsole();
     C_Output("");
 }
 
 //
 // cmdlist cmd
 //
-static void cmdlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+//
+// C_GetWildcardPrefix
+// Copies the part of a wildcard pattern before any wildcards into prefix.
+//
+static char *C_GetWildcardPrefix(char *pattern, char *prefix)
 {
     int i = 0;
-    int tabs[8] = { 174, 0, 0, 0, 0, 0, 0, 0 };
 
-    while (*consolecmds[i].name)
+    while (pattern[i] && pattern[i] != '*' && pattern[i] != '?' && i < 254)
+    {
+        prefix[i] = pattern[i];
+        ++i;
+    }
+
+    prefix[i] = '\0';
+    return prefix;
+}
+
+static void cmdlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    char    prefix[255];
+    int     position = C_GetFirstWithPrefix(C_GetWildcardPrefix(parm1, prefix));
+    int     tabs[8] = { 174, 0, 0, 0, 0, 0, 0, 0 };
+
+    for (; C_HasPrefix(position, prefix); ++position)
     {
+        int i = C_GetSortedIndex(position);
+
         if (consolecmds[i].type == CT_CMD && *consolecmds[i].description
             && (!*parm1 || wildcard(consolecmds[i].name, parm1)))
         {
@@ -1118,7 +1335,6 @@ static void cmdlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
             if (*description2)
                 C_TabbedOutput(tabs, "\t%s", description2);
         }
-        ++i;
     }
 }
 
@@ -1155,13 +1371,13 @@ static void condump_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
             int i;
 
             for (i = 1; i < consolestrings - 1; ++i)
-                if (console[i].type == dividerstring)
+                if (consoleline(i).type == dividerstring)
                     fprintf(file, "%s\n", DIVIDERSTRING);
                 else
                 {
                     unsigned int        inpos;
                     unsigned int        spaces;
-                    char                *string = strdup(console[i].string);
+                    char                *string = strdup(consoleline(i).string);
                     unsigned int        len;
                     unsigned int        outpos = 0;
                     int                 tabcount = 0;
@@ -1180,7 +1396,7 @@ static void condump_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
                         {
                             if (ch == '\t')
                             {
-                                unsigned int    tabstop = console[i].tabs[tabcount] / 5;
+                                unsigned int    tabstop = consoleline(i).tabs[tabcount] / 5;
 
                                 if (outpos < tabstop)
                                 {
@@ -1203,11 +1419,11 @@ static void condump_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
                         }
                     }
 
-                    if (con_timestamps && *console[i].timestamp)
+                    if (con_timestamps && *consoleline(i).timestamp)
                     {
                         for (spaces = 0; spaces < 91 - outpos; ++spaces)
                             fputc(' ', file);
-                        fputs(console[i].timestamp, file);
+                        fputs(consoleline(i).timestamp, file);
                     }
 
                     fputc('\n', file);
@@ -1225,11 +1441,14 @@ static void condump_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
 //
 static void cvarlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
 {
-    int i = 0;
-    int tabs[8] = { 149, 257, 0, 0, 0, 0, 0, 0 };
+    char    prefix[255];
+    int     position = C_GetFirstWithPrefix(C_GetWildcardPrefix(parm1, prefix));
+    int     tabs[8] = { 149, 257, 0, 0, 0, 0, 0, 0 };
 
-    while (*consolecmds[i].name)
+    for (; C_HasPrefix(position, prefix); ++position)
     {
+        int i = C_GetSortedIndex(position);
+
         if (consolecmds[i].type == CT_CVAR && (!*parm1 || wildcard(consolecmds[i].name, parm1)))
         {
             char        description1[255];
@@ -1292,7 +1511,6 @@ static void cvarlist_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
             if (*description2)
                 C_TabbedOutput(tabs, "\t\t%s", description2);
         }
-        ++i;
     }
 }
 
@@ -1358,6 +1576,53 @@ static void fastmonsters_cmd_func2(char *cmd, char *parm1, char *parm2, char *pa
     }
 }
 
+//
+// frametimes cmd
+//
+static void frametimes_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    if (*parm1)
+    {
+        char            filename[MAX_PATH];
+        const char      *appdatafolder = M_GetAppDataFolder();
+
+        M_MakeDirectory(appdatafolder);
+        M_snprintf(filename, sizeof(filename), "%s"DIR_SEPARATOR_S"%s", appdatafolder, parm1);
+
+        if (I_WriteFrameTimes(filename))
+            C_Output("Saved the times of the last <b>%s</b> frames to the file <b>%s</b>.",
+                commify(MIN(frametimecount, FRAMETIMES)), filename);
+        else
+            C_Warning("<b>%s</b> couldn't be saved.", filename);
+    }
+    else
+    {
+        int                     tabs[8] = { 160, 0, 0, 0, 0, 0, 0, 0 };
+        frametimestats_t        stats;
+
+        I_GetFrameTimeStats(&stats);
+
+        if (!stats.frames)
+        {
+            C_Output("No frames have been shown yet.");
+            return;
+        }
+
+        C_TabbedOutput(tabs, "Frames\t<b>%s</b>", commify(stats.frames));
+        C_TabbedOutput(tabs, "Average\t<b>%.2f ms</b> (<b>%.1f FPS</b>)", stats.average,
+            1000.0f / stats.average);
+        C_TabbedOutput(tabs, "50th percentile\t<b>%.2f ms</b>", stats.p50);
+        C_TabbedOutput(tabs, "95th percentile\t<b>%.2f ms</b>", stats.p95);
+        C_TabbedOutput(tabs, "99th percentile\t<b>%.2f ms</b>", stats.p99);
+        C_TabbedOutput(tabs, "Slowest\t<b>%.2f ms</b>", stats.worst);
+        C_TabbedOutput(tabs, "1%% low\t<b>%.1f FPS</b>", stats.low1);
+        C_TabbedOutput(tabs, "0.1%% low\t<b>%.1f FPS</b>", stats.low01);
+
+        if (vid_maxfps && !vid_capfps)
+            C_TabbedOutput(tabs, "Missed deadlines\t<b>%s</b>", commify(framesmissed));
+    }
+}
+
 //
 // give cmd
 //
@@ -2342,6 +2607,95 @@ static void mapstats_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
     }
 }
 
+//
+// memstats cmd
+//
+static void C_MemStats(int tabs[8], char *name, zonestats_t *stats)
+{
+    C_TabbedOutput(tabs, "%s\t<b>%s</b>\t<b>%s</b>\t<b>%s</b>\t<b>%s</b>", name,
+        commify(stats->blocks), convertsize((int)stats->bytes), commify(stats->maxblocks),
+        convertsize((int)stats->maxbytes));
+}
+
+static void memstats_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    int tabs[8] = { 150, 220, 310, 380, 0, 0, 0, 0 };
+    int i;
+
+    if (*parm1)
+    {
+        int     seconds = -1;
+
+        sscanf(parm1, "%10i", &seconds);
+
+        if (seconds < 0)
+            return;
+
+        zonelogtics = seconds * TICRATE;
+
+        if (seconds)
+            C_Output("A summary of how much memory is being used will be shown every <b>%s</b> "
+                "second%s.", commify(seconds), (seconds == 1 ? "" : "s"));
+        else
+            C_Output("A summary of how much memory is being used will no longer be shown.");
+        return;
+    }
+
+    C_TabbedOutput(tabs, "Tag\t<b>Blocks</b>\t<b>Size</b>\t<b>Max blocks</b>\t<b>Max size</b>");
+
+    for (i = PU_STATIC; i < PU_MAX; ++i)
+        C_MemStats(tabs, zonetagnames[i], &zonetagstats[i]);
+
+    C_MemStats(tabs, "Total", &zonetotalstats);
+
+    C_TabbedOutput(tabs, "Owner\t<b>Blocks</b>\t<b>Size</b>\t<b>Max blocks</b>\t<b>Max size</b>");
+
+    for (i = 0; i < NUMZONEOWNERS; ++i)
+        C_MemStats(tabs, zoneownernames[i], &zoneownerstats[i]);
+
+    C_MemStats(tabs, "Outside zone", &zonereallocstats);
+    C_MemStats(tabs, "Level arena", &zonearenastats);
+
+    C_Output("The cache has had <b>%s</b> hits and <b>%s</b> misses (a hit rate of <b>%i%%</b>), and "
+        "<b>%s</b> blocks have been evicted from it.", commify(zonecachehits),
+        commify(zonecachemisses), (int)(zonecachehits + zonecachemisses ?
+        zonecachehits * 100 / (zonecachehits + zonecachemisses) : 0), commify(zonecacheevictions));
+}
+
+//
+// mouselatency cmd
+//
+static void mouselatency_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    int tabs[8] = { 160, 0, 0, 0, 0, 0, 0, 0 };
+
+    if (!mouselatency)
+    {
+        mouselatency = true;
+        mouselatencycount = 0;
+        mouselatencytotal = 0;
+        mouselatencymax = 0;
+
+        C_Output("The time it takes for movement of the mouse to be shown is now being "
+            "measured. Move the mouse, and then enter <b>%s</b> again.", cmd);
+        return;
+    }
+
+    mouselatency = false;
+
+    if (!mouselatencycount)
+    {
+        C_Output("No movement of the mouse was measured.");
+        return;
+    }
+
+    C_TabbedOutput(tabs, "Frames\t<b>%s</b>", commify(mouselatencycount));
+    C_TabbedOutput(tabs, "Average\t<b>%.2f ms</b>",
+        mouselatencytotal / 1000000.0 / mouselatencycount);
+    C_TabbedOutput(tabs, "Slowest\t<b>%.2f ms</b>", mouselatencymax / 1000000.0);
+    C_TabbedOutput(tabs, "m_latelatch\t<b>%s</b>", (m_latelatch && !vid_capfps ? "on" : "off"));
+}
+
 //
 // noclip cmd
 //
@@ -2875,6 +3229,32 @@ static void playerstats_cmd_func2(char *cmd, char *parm1, char *parm2, char *par
         C_PlayerStats_NoGame();
 }
 
+//
+// profile cmd
+//
+static void profile_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    if (*parm1)
+    {
+        int     value = C_LookupValueFromAlias(parm1, 1);
+
+        if (value == 0)
+        {
+            M_StopProfiling();
+            C_Output("The frame profiler is now off.");
+        }
+        else if (value == 1)
+        {
+            M_StartProfiling();
+            C_Output("The frame profiler is now on.");
+        }
+    }
+    else if (M_ProfilingRequested())
+        M_ProfileSummary();
+    else
+        C_Output("The frame profiler is off. Enter <b>%s on</b> to turn it on.", cmd);
+}
+
 //
 // quit cmd
 //
@@ -2883,12 +3263,38 @@ static void quit_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
     I_Quit(true);
 }
 
+//
+// renderstats cmd
+//
+static void renderstats_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    int tabs[8] = { 160, 240, 320, 0, 0, 0, 0, 0 };
+    int i;
+
+    if (!rendercountersframes)
+    {
+        C_Output("No frames have been rendered yet.");
+        return;
+    }
+
+    C_TabbedOutput(tabs, "\t<b>Last</b>\t<b>Max</b>\t<b>Average</b>");
+
+    for (i = 0; i < NUMRENDERCOUNTERS; ++i)
+        C_TabbedOutput(tabs, "%s\t<b>%s</b>\t<b>%s</b>\t<b>%s</b>", rendercounternames[i],
+            commify(rendercounterslast[i]), commify(rendercountersmax[i]),
+            commify(rendercounterstotal[i] / rendercountersframes));
+
+    C_Output("The maximums and averages are of the <b>%s</b> frames rendered since the map "
+        "was loaded.", commify(rendercountersframes));
+}
+
 //
 // reset cmd
 //
 static void reset_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
 {
-    int i = 0;
+    int i;
+    int flags;
 
     if (!*parm1)
     {
@@ -2896,26 +3302,21 @@ static void reset_cmd_func2(char *cmd, char *parm1, char *parm2, char *parm3)
         return;
     }
 
-    while (*consolecmds[i].name)
-    {
-        int     flags = consolecmds[i].flags;
+    i = C_GetIndex(parm1);
+    flags = consolecmds[i].flags;
 
-        if (consolecmds[i].type == CT_CVAR && M_StringCompare(parm1, consolecmds[i].name)
-            && !(flags & CF_READONLY))
-        {
-            if (flags & (CF_BOOLEAN | CF_INTEGER))
-                consolecmds[i].func2(consolecmds[i].name,
-                    uncommify(C_LookupAliasFromValue((int)consolecmds[i].defaultnumber,
-                    consolecmds[i].aliases)), "", "");
-            else if (flags & CF_FLOAT)
-                consolecmds[i].func2(consolecmds[i].name,
-                    striptrailingzero(consolecmds[i].defaultnumber, 1), "", "");
-            else
-                consolecmds[i].func2(consolecmds[i].name, (*consolecmds[i].defaultstring ?
-                    consolecmds[i].defaultstring : "\"\""), "", "");
-            break;
-        }
-        ++i;
+    if (consolecmds[i].type == CT_CVAR && !(flags & CF_READONLY))
+    {
+        if (flags & (CF_BOOLEAN | CF_INTEGER))
+            consolecmds[i].func2(consolecmds[i].name,
+                uncommify(C_LookupAliasFromValue((int)consolecmds[i].defaultnumber,
+                consolecmds[i].aliases)), "", "");
+        else if (flags & CF_FLOAT)
+            consolecmds[i].func2(consolecmds[i].name,
+                striptrailingzero(consolecmds[i].defaultnumber, 1), "", "");
+        else
+            consolecmds[i].func2(consolecmds[i].name, (*consolecmds[i].defaultstring ?
+                consolecmds[i].defaultstring : "\"\""), "", "");
     }
 }
 
@@ -3741,6 +4142,23 @@ static void r_blood_cvar_func2(char *cmd, char *parm1, char *parm2, char *parm3)
     }
 }
 
+//
+// r_bloodsplats_max cvar
+//
+static void r_bloodsplats_max_cvar_func2(char *cmd, char *parm1, char *parm2, char *parm3)
+{
+    int r_bloodsplats_max_old = r_bloodsplats_max;
+
+    int_cvars_func2(cmd, parm1, "", "");
+    if (r_bloodsplats_max != r_bloodsplats_max_old)
+    {
+        if (gamestate == GS_LEVEL)
+            P_ClearBloodSplats();
+        P_BloodSplatSpawner = (r_blood == r_blood_none || !r_bloodsplats_max ?
+            P_NullBloodSplatSpawner : P_SpawnBloodSplat);
+    }
+}
+
 //
 // r_detail cvar
 //
@@ -3940,9 +4358,7 @@ static void r_translucency_cvar_func2(char *cmd, char *parm1, char *parm2, char
                 {
                     mobjtype_t  type = mo->type;
 
-                    if (type == MT_BLOODSPLAT)
-                        mo->colfunc = bloodsplatcolfunc;
-                    else if (type == MT_SHADOW)
+                    if (type == MT_SHADOW)
                         mo->colfunc = (mo->shadow->type == MT_SHADOWS ? R_DrawFuzzyShadowColumn :
                             (r_translucency ? R_DrawShadowColumn : R_DrawSolidShadowColumn));
                     else
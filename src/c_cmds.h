@@ -108,4 +108,10 @@ extern action_t         actions[];
 extern control_t        controls[];
 extern consolecmd_t     consolecmds[];
 
+void C_InitCmdIndex(void);
+int C_GetIndex(const char *cmd);
+int C_GetSortedIndex(int position);
+int C_GetFirstWithPrefix(const char *prefix);
+dboolean C_HasPrefix(int position, const char *prefix);
+
 #endif
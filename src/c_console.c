@@ -49,6 +49,7 @@
 #include "i_colors.h"
 #include "i_gamepad.h"
 #include "i_swap.h"
+#include "i_system.h"
 #include "i_timer.h"
 #include "m_menu.h"
 #include "m_misc.h"
@@ -81,6 +82,10 @@
 
 #define DIVIDER                 "~~~"
 
+#define FRAMEGRAPHWIDTH         120
+#define FRAMEGRAPHHEIGHT        40
+#define FRAMEGRAPHSCALE         50000   // microseconds shown by the full height of the graph
+
 #if !defined(WIN32)
 #define CARETBLINKTIME          530
 #endif
@@ -171,6 +176,139 @@ extern dboolean r_translucency;
 
 void G_ToggleAlwaysRun(evtype_t type);
 
+//
+// The scrollback is a ring of con_scrollback lines, the oldest of which is at
+// consolefirst. The text of the lines is kept in consolearena, a ring of bytes
+// that is written in the same order as the lines are added, so making room for
+// a new line only ever means dropping the oldest ones.
+//
+int             con_scrollback = con_scrollback_default;
+
+int             consolefirst;
+int             consolecapacity;
+
+// bytes of text allowed for each line of scrollback, on average
+#define CONSOLEARENALINESIZE    128
+
+static char     *consolearena;
+static size_t   consolearenasize;
+static size_t   consolearenahead;
+
+static void C_AddLine(stringtype_t type, char *string, int tabs[8], char *timestamp);
+
+static void C_RemoveOldestLine(void)
+{
+    consolefirst = (consolefirst + 1) % consolecapacity;
+    --consolestrings;
+
+    if (inputhistory > 0)
+        --inputhistory;
+    if (outputhistory > 0)
+        --outputhistory;
+}
+
+static void C_RemoveLastLine(void)
+{
+    // the text of the newest line is always the last thing written to the arena
+    consolearenahead = consoleline(--consolestrings).string - consolearena;
+}
+
+//
+// C_ResizeScrollback
+// Moves the newest lines into a scrollback of con_scrollback lines.
+//
+static void C_ResizeScrollback(void)
+{
+    console_t   *oldconsole = console;
+    char        *oldarena = consolearena;
+    int         oldfirst = consolefirst;
+    int         oldcapacity = consolecapacity;
+    int         oldstrings = consolestrings;
+    int         i;
+
+    consolecapacity = con_scrollback;
+    consolearenasize = MAX(consolecapacity * CONSOLEARENALINESIZE, CONSOLETEXTMAXLENGTH * 4);
+    console = malloc(consolecapacity * sizeof(*console));
+    consolearena = malloc(consolearenasize);
+
+    if (!console || !consolearena)
+        I_Error("C_ResizeScrollback: Failure trying to allocate %i lines of scrollback",
+            consolecapacity);
+
+    consolefirst = 0;
+    consolestrings = 0;
+    consolearenahead = 0;
+    inputhistory = -1;
+
+    for (i = MAX(0, oldstrings - consolecapacity); i < oldstrings; ++i)
+    {
+        console_t   *line = &oldconsole[(oldfirst + i) % oldcapacity];
+
+        C_AddLine(line->type, line->string, line->tabs, line->timestamp);
+    }
+
+    free(oldconsole);
+    free(oldarena);
+}
+
+//
+// C_AddLine
+// Adds a line to the end of the scrollback, dropping the oldest lines if
+// there is no room for it.
+//
+static void C_AddLine(stringtype_t type, char *string, int tabs[8], char *timestamp)
+{
+    size_t      length = strlen(string) + 1;
+    char        *text;
+    console_t   *line;
+
+    if (consolecapacity != con_scrollback)
+        C_ResizeScrollback();
+
+    if (consolestrings == consolecapacity)
+        C_RemoveOldestLine();
+
+    if (consolearenahead + length > consolearenasize)
+    {
+        // drop what is left of the previous pass through the arena before wrapping
+        while (consolestrings && consoleline(0).string >= consolearena + consolearenahead)
+            C_RemoveOldestLine();
+
+        consolearenahead = 0;
+    }
+
+    text = consolearena + consolearenahead;
+
+    while (consolestrings)
+    {
+        char    *oldest = consoleline(0).string;
+
+        if (oldest < text || oldest >= text + length)
+            break;
+
+        C_RemoveOldestLine();
+    }
+
+    memcpy(text, string, length);
+    consolearenahead += length;
+
+    line = &consoleline(consolestrings++);
+    line->string = text;
+    line->type = type;
+    memcpy(line->tabs, tabs, sizeof(line->tabs));
+    M_StringCopy(line->timestamp, timestamp, sizeof(line->timestamp));
+    outputhistory = -1;
+}
+
+void C_ClearConsole(void)
+{
+    consolefirst = 0;
+    consolestrings = 0;
+    consolearenahead = 0;
+    inputhistory = -1;
+    outputhistory = -1;
+}
+
 void C_Print(stringtype_t type, char *string, ...)
 {
     va_list     argptr;
@@ -180,12 +318,7 @@ void C_Print(stringtype_t type, char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, argptr);
     va_end(argptr);
 
-    console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-    M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-    console[consolestrings].type = type;
-    memset(console[consolestrings].tabs, 0, sizeof(console[consolestrings].tabs));
-    console[consolestrings++].timestamp[0] = '\0';
-    outputhistory = -1;
+    C_AddLine(type, buffer, notabs, "");
 }
 
 void C_Input(char *string, ...)
@@ -197,32 +330,27 @@ void C_Input(char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, argptr);
     va_end(argptr);
 
-    console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-    M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-    console[consolestrings].type = inputstring;
-    memset(console[consolestrings].tabs, 0, sizeof(console[consolestrings].tabs));
-    console[consolestrings++].timestamp[0] = '\0';
-    outputhistory = -1;
+    C_AddLine(inputstring, buffer, notabs, "");
 }
 
 void C_IntCVAROutput(char *cvar, int value)
 {
-    if (consolestrings && M_StringStartsWith(console[consolestrings - 1].string, cvar))
-        --consolestrings;
+    if (consolestrings && M_StringStartsWith(consoleline(consolestrings - 1).string, cvar))
+        C_RemoveLastLine();
     C_Input("%s %i", cvar, value);
 }
 
 void C_PctCVAROutput(char *cvar, int value)
 {
-    if (consolestrings && M_StringStartsWith(console[consolestrings - 1].string, cvar))
-        --consolestrings;
+    if (consolestrings && M_StringStartsWith(consoleline(consolestrings - 1).string, cvar))
+        C_RemoveLastLine();
     C_Input("%s %i%%", cvar, value);
 }
 
 void C_StrCVAROutput(char *cvar, char *string)
 {
-    if (consolestrings && M_StringStartsWith(console[consolestrings - 1].string, cvar))
-        --consolestrings;
+    if (consolestrings && M_StringStartsWith(consoleline(consolestrings - 1).string, cvar))
+        C_RemoveLastLine();
     C_Input("%s %s", cvar, string);
 }
 
@@ -235,12 +363,7 @@ void C_Output(char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, argptr);
     va_end(argptr);
 
-    console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-    M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-    console[consolestrings].type = outputstring;
-    memset(console[consolestrings].tabs, 0, sizeof(console[consolestrings].tabs));
-    console[consolestrings++].timestamp[0] = '\0';
-    outputhistory = -1;
+    C_AddLine(outputstring, buffer, notabs, "");
 }
 
 void C_TabbedOutput(int tabs[8], char *string, ...)
@@ -252,12 +375,7 @@ void C_TabbedOutput(int tabs[8], char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, argptr);
     va_end(argptr);
 
-    console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-    M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-    console[consolestrings].type = outputstring;
-    memcpy(console[consolestrings].tabs, tabs, sizeof(console[consolestrings].tabs));
-    console[consolestrings++].timestamp[0] = '\0';
-    outputhistory = -1;
+    C_AddLine(outputstring, buffer, tabs, "");
 }
 
 void C_Warning(char *string, ...)
@@ -269,23 +387,19 @@ void C_Warning(char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, argptr);
     va_end(argptr);
 
-    if (consolestrings && !M_StringCompare(console[consolestrings - 1].string, buffer))
-    {
-        console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-        M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-        console[consolestrings].type = warningstring;
-        memset(console[consolestrings].tabs, 0, sizeof(console[consolestrings].tabs));
-        console[consolestrings++].timestamp[0] = '\0';
-        outputhistory = -1;
-    }
+    if (consolestrings && !M_StringCompare(consoleline(consolestrings - 1).string, buffer))
+        C_AddLine(warningstring, buffer, notabs, "");
 }
 
 void C_PlayerMessage(char *string, ...)
 {
     va_list     argptr;
     char        buffer[CONSOLETEXTMAXLENGTH] = "";
-    dboolean    prevplayermessage = (consolestrings
-                    && console[consolestrings - 1].type == playermessagestring);
+    char        *prev = (consolestrings
+                    && consoleline(consolestrings - 1).type == playermessagestring ?
+                    consoleline(consolestrings - 1).string : NULL);
+    char        message[CONSOLETEXTMAXLENGTH];
+    char        timestamp[9];
     time_t      rawtime;
 
     va_start(argptr, string);
@@ -293,30 +407,24 @@ void C_PlayerMessage(char *string, ...)
     va_end(argptr);
 
     time(&rawtime);
+    strftime(timestamp, sizeof(timestamp), "%H:%M:%S", localtime(&rawtime));
 
-    if (prevplayermessage && M_StringCompare(console[consolestrings - 1].string, buffer))
+    if (prev && M_StringCompare(prev, buffer))
     {
-        M_snprintf(console[consolestrings - 1].string, CONSOLETEXTMAXLENGTH, "%s (2)", buffer);
-        strftime(console[consolestrings - 1].timestamp, 9, "%H:%M:%S", localtime(&rawtime));
+        M_snprintf(message, CONSOLETEXTMAXLENGTH, "%s (2)", buffer);
+        C_RemoveLastLine();
     }
-    else if (prevplayermessage && M_StringStartsWith(console[consolestrings - 1].string, buffer))
+    else if (prev && M_StringStartsWith(prev, buffer))
     {
-        char    *count = strrchr(console[consolestrings - 1].string, '(') + 1;
+        char    *count = strrchr(prev, '(') + 1;
 
-        count[strlen(count) - 1] = '\0';
-        M_snprintf(console[consolestrings - 1].string, CONSOLETEXTMAXLENGTH, "%s (%i)", buffer,
-            atoi(count) + 1);
-        strftime(console[consolestrings - 1].timestamp, 9, "%H:%M:%S", localtime(&rawtime));
+        M_snprintf(message, CONSOLETEXTMAXLENGTH, "%s (%i)", buffer, atoi(count) + 1);
+        C_RemoveLastLine();
     }
     else
-    {
-        console = Z_Realloc(console, (consolestrings + 1) * sizeof(*console));
-        M_StringCopy(console[consolestrings].string, buffer, CONSOLETEXTMAXLENGTH);
-        console[consolestrings].type = playermessagestring;
-        memset(console[consolestrings].tabs, 0, sizeof(console[consolestrings].tabs));
-        strftime(console[consolestrings++].timestamp, 9, "%H:%M:%S", localtime(&rawtime));
-    }
-    outputhistory = -1;
+        M_StringCopy(message, buffer, CONSOLETEXTMAXLENGTH);
+
+    C_AddLine(playermessagestring, message, notabs, timestamp);
 }
 
 static void C_AddToUndoHistory(void)
@@ -331,7 +439,7 @@ static void C_AddToUndoHistory(void)
 
 void C_AddConsoleDivider(void)
 {
-    if (!consolestrings || !M_StringCompare(console[consolestrings - 1].string, DIVIDER))
+    if (!consolestrings || !M_StringCompare(consoleline(consolestrings - 1).string, DIVIDER))
         C_Print(dividerstring, DIVIDER);
 }
 
@@ -456,6 +564,7 @@ void C_Init(void)
     char        buffer[9];
 
     while (*consolecmds[numconsolecmds++].name);
+    C_InitCmdIndex();
 
     unknownchar = W_CacheLumpName("DRFON000", PU_STATIC);
     for (i = 0; i < CONSOLEFONTSIZE; i++)
@@ -766,19 +875,91 @@ static void C_DrawTimeStamp(int x, int y, char *text)
     }
 }
 
+//
+// C_DrawFrameTimeGraph
+// Draws a bar for each of the most recent frames, with its height
+// proportional to how long the frame took.
+//
+static void C_DrawFrameTimeGraph(int x, int y)
+{
+    unsigned int        count = MIN(frametimecount, FRAMEGRAPHWIDTH);
+    unsigned int        i;
+
+    for (i = 0; i < count; ++i)
+    {
+        uint32_t        frametime = frametimes[(frametimecount - count + i) % FRAMETIMES];
+        int             height = (int)MIN(frametime / (FRAMEGRAPHSCALE / FRAMEGRAPHHEIGHT),
+                            FRAMEGRAPHHEIGHT);
+        int             color = (frametime > 1000000 / TICRATE ? consolelowfpscolor :
+                            consolehighfpscolor);
+        byte            *dest = screens[0] + (y + FRAMEGRAPHHEIGHT - 1) * SCREENWIDTH + x
+                            + FRAMEGRAPHWIDTH - count + i;
+
+        while (height-- > 0)
+        {
+            *dest = color;
+            dest -= SCREENWIDTH;
+        }
+    }
+}
+
 void C_UpdateFPS(void)
 {
     if (fps && !wipe)
     {
-        static char     buffer[16];
+        static char             buffer[16];
+        static char             buffer2[32];
+        static frametimestats_t stats;
+        static unsigned int     statsframe;
 
         M_snprintf(buffer, 16, "%i FPS", fps);
 
         C_DrawOverlayText(SCREENWIDTH - C_TextWidth(buffer, false) - CONSOLETEXTX + 1,
             CONSOLETEXTY, buffer, (fps < TICRATE ? consolelowfpscolor : consolehighfpscolor));
+
+        // percentiles are only recalculated about once a second
+        if (frametimecount - statsframe >= (unsigned int)fps)
+        {
+            I_GetFrameTimeStats(&stats);
+            statsframe = frametimecount;
+        }
+
+        if (stats.frames)
+        {
+            M_snprintf(buffer2, 32, "%i 1%% low, %.1f ms p99", (int)stats.low1, stats.p99);
+
+            C_DrawOverlayText(SCREENWIDTH - C_TextWidth(buffer2, false) - CONSOLETEXTX + 1,
+                CONSOLETEXTY + CONSOLELINEHEIGHT, buffer2,
+                (stats.low1 < TICRATE ? consolelowfpscolor : consolehighfpscolor));
+
+            C_DrawFrameTimeGraph(SCREENWIDTH - FRAMEGRAPHWIDTH - CONSOLETEXTX,
+                CONSOLETEXTY + CONSOLELINEHEIGHT * 2 + 2);
+        }
     }
 }
 
+void C_UpdateRenderStats(void)
+{
+    static char buffer[4][64];
+    int         i;
+    int         y = CONSOLETEXTY + (vid_showfps ? CONSOLELINEHEIGHT * 2 + FRAMEGRAPHHEIGHT + 6 : 0);
+
+    M_snprintf(buffer[0], 64, "%i nodes, %i subsectors", rendercounterslast[RC_NODES],
+        rendercounterslast[RC_SUBSECTORS]);
+    M_snprintf(buffer[1], 64, "%i drawsegs, %i columns, %i openings",
+        rendercounterslast[RC_DRAWSEGS], rendercounterslast[RC_WALLCOLUMNS],
+        rendercounterslast[RC_OPENINGS]);
+    M_snprintf(buffer[2], 64, "%i visplanes, %i pixels", rendercounterslast[RC_VISPLANES],
+        rendercounterslast[RC_SPANPIXELS]);
+    M_snprintf(buffer[3], 64, "%i+%i+%i sprites, %i columns", rendercounterslast[RC_VISSPRITES],
+        rendercounterslast[RC_BLOODSPLATVISSPRITES], rendercounterslast[RC_SHADOWVISSPRITES],
+        rendercounterslast[RC_MASKEDCOLUMNS]);
+
+    for (i = 0; i < 4; ++i, y += CONSOLELINEHEIGHT)
+        C_DrawOverlayText(SCREENWIDTH - C_TextWidth(buffer[i], false) - CONSOLETEXTX + 1, y,
+            buffer[i], consolehighfpscolor);
+}
+
 void C_Drawer(void)
 {
     if (consoleheight)
@@ -836,17 +1017,17 @@ void C_Drawer(void)
         {
             int                 y = CONSOLELINEHEIGHT * (i - start + MAX(0, CONSOLELINES
                                     - consolestrings)) - CONSOLELINEHEIGHT / 2 + 1;
-            stringtype_t        type = console[i].type;
+            stringtype_t        type = consoleline(i).type;
 
             if (type == dividerstring)
                 V_DrawConsolePatch(CONSOLETEXTX, y + 5 - (CONSOLEHEIGHT - consoleheight), divider,
                     consoledividercolor, NOBACKGROUNDCOLOR, false, tinttab50);
             else
             {
-                C_DrawConsoleText(CONSOLETEXTX, y, console[i].string, consolecolors[type],
-                    NOBACKGROUNDCOLOR, consoleboldcolor, tinttab66, console[i].tabs, true);
-                if (con_timestamps && *console[i].timestamp)
-                    C_DrawTimeStamp(timestampx, y, console[i].timestamp);
+                C_DrawConsoleText(CONSOLETEXTX, y, consoleline(i).string, consolecolors[type],
+                    NOBACKGROUNDCOLOR, consoleboldcolor, tinttab66, consoleline(i).tabs, true);
+                if (con_timestamps && *consoleline(i).timestamp)
+                    C_DrawTimeStamp(timestampx, y, consoleline(i).timestamp);
             }
         }
 
@@ -930,67 +1111,62 @@ void C_Drawer(void)
 
 static dboolean C_ValidateInput(char *input)
 {
-    int i = 0;
+    size_t      length = strlen(input);
+    int         i;
+    char        cmd[256] = "";
+    char        parm1[256] = "";
+    char        parm2[256] = "";
+    char        parm3[256] = "";
 
-    while (*consolecmds[i].name)
+    // cheats that end with a two digit parameter
+    if (length >= 2 && isdigit(input[length - 2]) && isdigit(input[length - 1]))
     {
-        char    cmd[256] = "";
+        M_StringCopy(cmd, input, 255);
+        cmd[length - 2] = '\0';
+        i = C_GetIndex(cmd);
 
-        if (consolecmds[i].type == CT_CHEAT)
+        if (consolecmds[i].type == CT_CHEAT && consolecmds[i].parameters)
         {
-            if (consolecmds[i].parameters)
-            {
-                size_t  length = strlen(input);
-
-                if (isdigit(input[length - 2]) && isdigit(input[length - 1]))
-                {
-                    consolecheatparm[0] = input[length - 2];
-                    consolecheatparm[1] = input[length - 1];
-                    consolecheatparm[2] = '\0';
+            consolecheatparm[0] = input[length - 2];
+            consolecheatparm[1] = input[length - 1];
+            consolecheatparm[2] = '\0';
 
-                    M_StringCopy(cmd, input, 255);
-                    cmd[length - 2] = '\0';
-
-                    if ((M_StringCompare(cmd, consolecmds[i].name)
-                        || M_StringCompare(cmd, consolecmds[i].alternate))
-                        && length == strlen(cmd) + 2
-                        && consolecmds[i].func1(consolecmds[i].name, consolecheatparm, "", ""))
-                    {
-                        M_StringCopy(consolecheat, cmd, 255);
-                        return true;
-                    }
-                }
-            }
-            else if ((M_StringCompare(input, consolecmds[i].name)
-                || M_StringCompare(input, consolecmds[i].alternate))
-                && consolecmds[i].func1(consolecmds[i].name, "", "", ""))
+            if (consolecmds[i].func1(consolecmds[i].name, consolecheatparm, "", ""))
             {
-                M_StringCopy(consolecheat, input, 255);
+                M_StringCopy(consolecheat, cmd, 255);
                 return true;
             }
         }
-        else
+    }
+
+    // cheats without a parameter
+    i = C_GetIndex(input);
+
+    if (consolecmds[i].type == CT_CHEAT)
+    {
+        if (!consolecmds[i].parameters && consolecmds[i].func1(consolecmds[i].name, "", "", ""))
         {
-            char        parm1[256] = "";
-            char        parm2[256] = "";
-            char        parm3[256] = "";
-
-            sscanf(input, "%255s %255s %255s %255s", cmd, parm1, parm2, parm3);
-            C_StripQuotes(parm1);
-            C_StripQuotes(parm2);
-            C_StripQuotes(parm3);
-            if ((M_StringCompare(cmd, consolecmds[i].name)
-                || M_StringCompare(cmd, consolecmds[i].alternate))
-                && consolecmds[i].func1(consolecmds[i].name, parm1, parm2, parm3)
-                && (consolecmds[i].parameters || (!*parm1 && !*parm2 && !*parm3)))
-            {
-                C_Input((input[strlen(input) - 1] == '%' ? "%s%" : "%s"), input);
-                consolecmds[i].func2(consolecmds[i].name, uncommify(parm1), parm2, parm3);
-                return true;
-            }
+            M_StringCopy(consolecheat, input, 255);
+            return true;
         }
-        ++i;
     }
+
+    // commands and cvars
+    sscanf(input, "%255s %255s %255s %255s", cmd, parm1, parm2, parm3);
+    C_StripQuotes(parm1);
+    C_StripQuotes(parm2);
+    C_StripQuotes(parm3);
+    i = C_GetIndex(cmd);
+
+    if (*consolecmds[i].name && consolecmds[i].type != CT_CHEAT
+        && consolecmds[i].func1(consolecmds[i].name, parm1, parm2, parm3)
+        && (consolecmds[i].parameters || (!*parm1 && !*parm2 && !*parm3)))
+    {
+        C_Input((input[length - 1] == '%' ? "%s%" : "%s"), input);
+        consolecmds[i].func2(consolecmds[i].name, uncommify(parm1), parm2, parm3);
+        return true;
+    }
+
     return false;
 }
 
@@ -1182,19 +1358,29 @@ dboolean C_Responder(event_t *ev)
                     int start = autocomplete;
 
                     if (autocomplete == -1)
+                    {
                         M_StringCopy(autocompletetext, consoleinput, sizeof(autocompletetext));
+                        autocomplete = C_GetFirstWithPrefix(autocompletetext) - 1;
+                    }
 
+                    // commands starting with the text are next to each other when sorted
                     while ((direction == -1 && autocomplete > 0)
-                        || (direction == 1 && autocomplete < numconsolecmds - 1))
+                        || (direction == 1 && autocomplete < numconsolecmds - 2))
                     {
+                        consolecmd_t    *consolecmd;
+
                         autocomplete += direction;
-                        if (M_StringStartsWith(consolecmds[autocomplete].name, autocompletetext)
-                            && consolecmds[autocomplete].type != CT_CHEAT
-                            && *consolecmds[autocomplete].description)
+
+                        if (!C_HasPrefix(autocomplete, autocompletetext))
+                            break;
+
+                        consolecmd = &consolecmds[C_GetSortedIndex(autocomplete)];
+
+                        if (M_StringStartsWith(consolecmd->name, autocompletetext)
+                            && consolecmd->type != CT_CHEAT && *consolecmd->description)
                         {
-                            M_StringCopy(consoleinput, consolecmds[autocomplete].name,
-                                sizeof(consoleinput));
-                            if (consolecmds[autocomplete].parameters)
+                            M_StringCopy(consoleinput, consolecmd->name, sizeof(consoleinput));
+                            if (consolecmd->parameters)
                             {
                                 int     length = strlen(consoleinput);
 
@@ -1216,11 +1402,11 @@ dboolean C_Responder(event_t *ev)
                 if (inputhistory == -1)
                     M_StringCopy(currentinput, consoleinput, sizeof(currentinput));
                 for (i = (inputhistory == -1 ? consolestrings : inputhistory) - 1; i >= 0; --i)
-                    if (console[i].type == inputstring
-                        && !M_StringCompare(consoleinput, console[i].string))
+                    if (consoleline(i).type == inputstring
+                        && !M_StringCompare(consoleinput, consoleline(i).string))
                     {
                         inputhistory = i;
-                        M_StringCopy(consoleinput, console[i].string, 255);
+                        M_StringCopy(consoleinput, consoleline(i).string, 255);
                         caretpos = selectstart = selectend = strlen(consoleinput);
                         caretwait = I_GetTimeMS() + caretblinktime;
                         showcaret = true;
@@ -1233,11 +1419,11 @@ dboolean C_Responder(event_t *ev)
                 if (inputhistory != -1)
                 {
                     for (i = inputhistory + 1; i < consolestrings; ++i)
-                        if (console[i].type == inputstring
-                            && !M_StringCompare(consoleinput, console[i].string))
+                        if (consoleline(i).type == inputstring
+                            && !M_StringCompare(consoleinput, consoleline(i).string))
                         {
                             inputhistory = i;
-                            M_StringCopy(consoleinput, console[i].string, 255);
+                            M_StringCopy(consoleinput, consoleline(i).string, 255);
                             break;
                         }
                     if (i == consolestrings)
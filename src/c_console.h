@@ -73,7 +73,7 @@ typedef enum
 
 typedef struct
 {
-    char                string[1024];
+    char                *string;
     stringtype_t        type;
     int                 tabs[8];
     char                timestamp[9];
@@ -81,6 +81,13 @@ typedef struct
 
 console_t               *console;
 
+extern int              consolestrings;
+extern int              consolefirst;
+extern int              consolecapacity;
+
+// the line in the scrollback that is i lines after the oldest one
+#define consoleline(i)          console[(consolefirst + (i)) % consolecapacity]
+
 extern dboolean         consoleactive;
 extern int              consoleheight;
 extern int              consoledirection;
@@ -109,6 +116,7 @@ void C_TabbedOutput(int tabs[8], char *string, ...);
 void C_Warning(char *string, ...);
 void C_PlayerMessage(char *string, ...);
 void C_AddConsoleDivider(void);
+void C_ClearConsole(void);
 void C_Init(void);
 void C_ShowConsole(void);
 void C_HideConsole(void);
@@ -119,5 +127,6 @@ void C_PrintCompileDate(void);
 void C_PrintSDLVersions(void);
 void C_StripQuotes(char *string);
 void C_UpdateFPS(void);
+void C_UpdateRenderStats(void);
 
 #endif
@@ -42,6 +42,7 @@
 #include "d_deh.h"
 #include "doomstat.h"
 #include "dstrings.h"
+#include "m_cache.h"
 #include "m_cheat.h"
 #include "m_misc.h"
 #include "p_local.h"
@@ -1901,12 +1902,12 @@ dboolean CheckPackageWADVersion(void)
 
                 if (M_StringCompare(inbuffer, PACKAGE_NAMEANDVERSIONSTRING))
                 {
-                    Z_ChangeTag(infile.lump, PU_CACHE);
+                    W_ReleaseLumpNum(i);
                     return true;
                 }
             }
 
-            Z_ChangeTag(infile.lump, PU_CACHE);
+            W_ReleaseLumpNum(i);
         }
     return false;
 }
@@ -1933,6 +1934,7 @@ void ProcessDehFile(char *filename, int lumpnum)
         if (!(infile.f = fopen(filename, "rt")))
             return;             // should be checked up front anyway
         infile.lump = NULL;
+        M_AddStartupCacheFile(filename);
         C_Output("Parsed the <b><i>DeHackEd%s</i></b> file <b>%s</b>.",
             (M_StringEndsWith(uppercase(filename), "BEX") ? " with <b><i>BOOM</i></b> extensions"
             : ""), filename);
@@ -2049,7 +2051,7 @@ void ProcessDehFile(char *filename, int lumpnum)
     }
 
     if (infile.lump)
-        Z_ChangeTag(infile.lump, PU_CACHE);     // Mark purgeable
+        W_ReleaseLumpNum(lumpnum);              // Mark purgeable
     else
         fclose(infile.f);                       // Close real file
 
@@ -36,12 +36,19 @@
 ========================================================================
 */
 
+#include "c_console.h"
 #include "d_main.h"
 #include "doomstat.h"
 #include "g_game.h"
 #include "m_menu.h"
 #include "i_system.h"
 #include "i_timer.h"
+#include "p_tick.h"
+#include "r_main.h"
+#include "st_stuff.h"
+#include "v_video.h"
+#include "w_wad.h"
+#include "z_zone.h"
 
 // Maximum time that we wait in TryRunTics() for netgame data to be
 // received before we bail out and render a frame anyway.
@@ -65,6 +72,24 @@ int             maketic;
 // Used for original sync code.
 int             skiptics = 0;
 
+// Headless playsim: run tics as fast as possible without drawing
+dboolean        nodraw;
+int             nodrawtics = 35 * 60 * 10;
+
+static ticcmd_t *scriptcmds;
+static int      numscriptcmds;
+
+// Golden frame checksums, either being recorded or checked against
+static FILE     *framefile;
+static dboolean recordingframes;
+static int      frameinterval;
+static int      nextframetic = -1;
+static uint64_t nextframechecksum;
+
+extern int      st_palette;
+
+void R_ExecuteSetViewSize(void);
+
 //
 // NetUpdate
 // Builds ticcmds for console player,
@@ -165,7 +190,9 @@ void TryRunTics(void)
             if (I_GetTime() - entertic >= MAX_NETGAME_STALL_TICS)
                 return;
 
-            I_Sleep(1);
+            // sleep for whole ms until the next tic is close, then just yield so
+            // the tic starts on time
+            I_Sleep((int)(I_GetTimeToNextTic() / 1000000));
         }
     }
 
@@ -185,3 +212,222 @@ void TryRunTics(void)
         NetUpdate();
     }
 }
+
+//
+// D_LoadTicCmdScript
+// Reads the ticcmds used by D_RunHeadless. Each line of the file holds the
+// forwardmove, sidemove, angleturn and buttons of a ticcmd, optionally
+// followed by the number of tics to repeat it for. The script loops.
+//
+dboolean D_LoadTicCmdScript(char *filename)
+{
+    FILE        *file = fopen(filename, "rt");
+    char        line[256];
+
+    if (!file)
+        return false;
+
+    while (fgets(line, sizeof(line), file))
+    {
+        int         forwardmove;
+        int         sidemove;
+        int         angleturn;
+        int         buttons;
+        int         repeat = 1;
+        ticcmd_t    cmd;
+
+        if (sscanf(line, "%10i %10i %10i %10i %10i", &forwardmove, &sidemove, &angleturn,
+            &buttons, &repeat) < 4)
+            continue;
+
+        cmd.forwardmove = (signed char)forwardmove;
+        cmd.sidemove = (signed char)sidemove;
+        cmd.angleturn = (short)angleturn;
+        cmd.buttons = (byte)(buttons & ~BT_SPECIAL);
+
+        scriptcmds = Z_Realloc(scriptcmds,
+            (numscriptcmds + MAX(repeat, 1)) * sizeof(*scriptcmds));
+
+        do
+            scriptcmds[numscriptcmds++] = cmd;
+        while (--repeat > 0);
+    }
+
+    fclose(file);
+    return (numscriptcmds > 0);
+}
+
+//
+// D_OpenFrameChecksums
+// Opens a file of checksums of frames rendered by D_RunHeadless. When
+// recording, a frame is rendered and written every interval tics. When
+// checking, a frame is rendered at each tic in the file, and the run stops
+// at the first frame that doesn't match, or fails if the file has no frames
+// or the run ends before every frame in it has been checked.
+//
+dboolean D_OpenFrameChecksums(char *filename, dboolean record, int interval)
+{
+    if (!(framefile = fopen(filename, (record ? "wt" : "rt"))))
+        return false;
+
+    recordingframes = record;
+    frameinterval = MAX(1, interval);
+    return true;
+}
+
+static void D_ReadNextFrameChecksum(void)
+{
+    char                line[256];
+    unsigned long long  checksum;
+
+    nextframetic = -1;
+
+    while (fgets(line, sizeof(line), framefile))
+        if (sscanf(line, "%10i %16llx", &nextframetic, &checksum) == 2)
+        {
+            nextframechecksum = checksum;
+            return;
+        }
+        else
+            nextframetic = -1;
+}
+
+//
+// D_FrameChecksum
+// FNV-1a hash of the screen and the palette it's shown with.
+//
+static uint64_t D_FrameChecksum(void)
+{
+    uint64_t    hash = 14695981039346656037ULL;
+    byte        *palette = (byte *)W_CacheLumpName("PLAYPAL", PU_CACHE)
+                    + MAX(st_palette, 0) * 768;
+    int         i;
+
+    for (i = 0; i < SCREENWIDTH * SCREENHEIGHT; ++i)
+        hash = (hash ^ screens[0][i]) * 1099511628211ULL;
+
+    for (i = 0; i < 768; ++i)
+        hash = (hash ^ palette[i]) * 1099511628211ULL;
+
+    return hash;
+}
+
+//
+// D_RunHeadless
+// Used instead of D_DoomLoop when -nodraw is on the command-line. Runs
+// nodrawtics tics back to back, with no drawing or waiting between them,
+// then reports how quickly they ran and quits.
+//
+void D_RunHeadless(void)
+{
+    int         tics = 0;
+    int         frames = 0;
+    uint64_t    start;
+    uint64_t    elapsed;
+    uint64_t    rendertime = 0;
+    uint64_t    maxrendertime = 0;
+    dboolean    oldcapfps = vid_capfps;
+
+    runthinkerstime = 0;
+    maxrunthinkerstime = 0;
+
+    if (framefile)
+    {
+        // frames are rendered without interpolation so they only depend on the
+        // tic they're rendered at
+        vid_capfps = true;
+        R_ExecuteSetViewSize();
+
+        if (!recordingframes)
+        {
+            D_ReadNextFrameChecksum();
+
+            if (nextframetic == -1)
+            {
+                vid_capfps = oldcapfps;
+                I_Error("No frame checksums could be read from the file given with "
+                    "-checkframes.");
+            }
+        }
+    }
+
+    start = I_GetTimeUS();
+
+    while (tics < nodrawtics)
+    {
+        ticcmd_t    cmd = { 0, 0, 0, 0 };
+
+        if (numscriptcmds)
+            cmd = scriptcmds[tics % numscriptcmds];
+
+        netcmds[gametic % BACKUPTICS] = cmd;
+        maketic = gametic + 1;
+
+        G_Ticker();
+        gametic++;
+        gametime++;
+        tics++;
+
+        // stop once the map has been exited
+        if (gamestate != GS_LEVEL && gameaction == ga_nothing)
+            break;
+
+        if (framefile && (recordingframes ? !(tics % frameinterval) : tics == nextframetic))
+        {
+            uint64_t    renderstart = I_GetTimeUS();
+            uint64_t    checksum;
+
+            R_RenderPlayerView(&players[0]);
+
+            elapsed = I_GetTimeUS() - renderstart;
+            rendertime += elapsed;
+            if (elapsed > maxrendertime)
+                maxrendertime = elapsed;
+            ++frames;
+
+            ST_doPaletteStuff();
+            checksum = D_FrameChecksum();
+
+            if (recordingframes)
+                fprintf(framefile, "%i %016llx %u\n", tics, (unsigned long long)checksum,
+                    (unsigned int)elapsed);
+            else if (checksum != nextframechecksum)
+            {
+                vid_capfps = oldcapfps;
+                I_Error("The frame rendered at tic %i doesn't match. Its checksum is %016llx "
+                    "instead of %016llx.", tics, (unsigned long long)checksum,
+                    (unsigned long long)nextframechecksum);
+            }
+            else
+                D_ReadNextFrameChecksum();
+        }
+    }
+
+    if (!(elapsed = I_GetTimeUS() - start))
+        elapsed = 1;
+
+    C_Output("Ran <b>%i</b> tics in <b>%.2f</b> seconds (<b>%.0f</b> tics per second).",
+        tics, elapsed / 1000000.0, tics * 1000000.0 / elapsed);
+    printf("tics=%i seconds=%.3f ticspersecond=%.1f runthinkersus=%.1f maxrunthinkersus=%u\n",
+        tics, elapsed / 1000000.0, tics * 1000000.0 / elapsed,
+        (double)runthinkerstime / MAX(tics, 1), (unsigned int)maxrunthinkerstime);
+
+    if (framefile)
+    {
+        fclose(framefile);
+        vid_capfps = oldcapfps;
+
+        if (!recordingframes && nextframetic != -1)
+            I_Error("The run ended at tic %i, before the frame at tic %i could be checked.",
+                tics, nextframetic);
+
+        C_Output("<b>%i</b> frames were %s, taking <b>%.2f</b> milliseconds each to render on "
+            "average.", frames, (recordingframes ? "recorded" : "checked"),
+            rendertime / 1000.0 / MAX(frames, 1));
+        printf("frames=%i %s renderus=%.1f maxrenderus=%u\n", frames,
+            (recordingframes ? "recorded" : "matched"), (double)rendertime / MAX(frames, 1),
+            (unsigned int)maxrendertime);
+    }
+
+    I_Quit(false);
+}
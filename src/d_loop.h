@@ -39,6 +39,8 @@
 #if !defined(__D_LOOP_H__)
 #define __D_LOOP_H__
 
+#include "doomtype.h"
+
 // Networking and tic handling related.
 #define BACKUPTICS      128
 
@@ -51,4 +53,12 @@ void TryRunTics(void);
 // Called at start of game loop to initialize timers
 void D_StartGameLoop(void);
 
+// Headless playsim, started with -nodraw
+extern dboolean nodraw;
+extern int      nodrawtics;
+
+dboolean D_LoadTicCmdScript(char *filename);
+dboolean D_OpenFrameChecksums(char *filename, dboolean record, int interval);
+void D_RunHeadless(void);
+
 #endif
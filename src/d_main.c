@@ -58,16 +58,22 @@
 #include "f_wipe.h"
 #include "g_game.h"
 #include "hu_stuff.h"
+#include "i_colors.h"
 #include "i_gamepad.h"
 #include "i_swap.h"
 #include "i_system.h"
+#include "i_tasks.h"
 #include "i_timer.h"
 #include "m_argv.h"
+#include "m_cache.h"
 #include "m_menu.h"
 #include "m_misc.h"
+#include "m_profile.h"
+#include "m_random.h"
 #include "p_local.h"
 #include "p_saveg.h"
 #include "p_setup.h"
+#include "p_stress.h"
 #include "s_sound.h"
 #include "st_stuff.h"
 #include "v_video.h"
@@ -276,7 +282,9 @@ void D_Display(void)
     {
         HU_Erase();
 
+        PROFILE_BEGIN(PROF_ST_DRAWER);
         ST_Drawer((viewheight == SCREENHEIGHT), true);
+        PROFILE_END(PROF_ST_DRAWER);
 
         // draw the view directly
         R_RenderPlayerView(&players[0]);
@@ -299,7 +307,8 @@ void D_Display(void)
         {
             if (scaledviewwidth != SCREENWIDTH)
             {
-                if (menuactive || menuactivestate || !viewactivestate || vid_showfps || paused
+                if (menuactive || menuactivestate || !viewactivestate || vid_showfps
+                    || r_showrenderstats || paused
                     || pausedstate || message_on || consoleheight > CONSOLETOP)
                     borderdrawcount = 3;
                 if (borderdrawcount)
@@ -312,7 +321,9 @@ void D_Display(void)
                 V_LowGraphicDetail();
         }
 
+        PROFILE_BEGIN(PROF_HU_DRAWER);
         HU_Drawer();
+        PROFILE_END(PROF_HU_DRAWER);
     }
 
     menuactivestate = menuactive;
@@ -345,7 +356,9 @@ void D_Display(void)
 
     if (!wipe)
     {
+        PROFILE_BEGIN(PROF_C_DRAWER);
         C_Drawer();
+        PROFILE_END(PROF_C_DRAWER);
 
         // menus go directly to the screen
         M_Drawer();             // menu is drawn even on top of everything
@@ -353,8 +366,14 @@ void D_Display(void)
         if (drawdisk)
             HU_DrawDisk();
 
+        if (r_showrenderstats && gamestate == GS_LEVEL)
+            C_UpdateRenderStats();
+
         // normal update
+        PROFILE_BEGIN(PROF_BLITFUNC);
         blitfunc();             // blit buffer
+        PROFILE_END(PROF_BLITFUNC);
+        I_UpdateFrameTimes();
 
         mapblitfunc();
 
@@ -384,6 +403,7 @@ void D_Display(void)
 
         M_Drawer();             // menu is drawn even on top of wipes
         blitfunc();             // page flip or blit buffer
+        I_UpdateFrameTimes();
 
         mapblitfunc();
     }
@@ -404,13 +424,30 @@ void D_DoomLoop(void)
 
     while (1)
     {
+        M_ProfileStartFrame();
+
+        I_StartFrameLimiter();
+
+        PROFILE_BEGIN(PROF_TRYRUNTICS);
         TryRunTics(); // will run at least one tic
+        PROFILE_END(PROF_TRYRUNTICS);
+
+        Z_TrimCache();
+        Z_LogStats();
 
         if (players[0].mo)
             S_UpdateSounds(players[0].mo);  // move positional sounds
 
+        I_LatchMouse();
+
         // Update display, next frame, with current state.
+        PROFILE_BEGIN(PROF_D_DISPLAY);
         D_Display();
+        PROFILE_END(PROF_D_DISPLAY);
+
+        I_EndFrameLimiter();
+
+        M_ProfileEndFrame();
     }
 }
 
@@ -1509,6 +1546,48 @@ static void D_ParseStartupString(const char *string)
         }
 }
 
+static void D_InitSound(void)
+{
+    S_Init((int)(sfxVolume * 127.0f / 15.0f), (int)(musicVolume * 127.0f / 15.0f));
+}
+
+//
+// D_InitSubsystems
+//
+// Only those steps that don't touch the zone, the WADs or the console are
+// marked to run on a worker thread, and every other step still runs on the
+// main thread in this order, apart from waiting on what it depends on.
+//
+static task_t startuptasks[] =
+{
+    { "S_CheckParms",         S_CheckParms,         false, { NULL                   } },
+    { "S_OpenAudio",          S_OpenAudio,          true,  { "S_CheckParms"         } },
+    { "I_GenerateTintTables", I_GenerateTintTables, true,  { NULL                   } },
+    { "M_Init",               M_Init,               false, { NULL                   } },
+    { "R_Init",               R_Init,               false, { NULL                   } },
+    { "P_Init",               P_Init,               false, { "R_Init"               } },
+    { "S_Init",               D_InitSound,          false, { "S_OpenAudio"          } },
+    { "HU_Init",              HU_Init,              false, { NULL                   } },
+    { "ST_Init",              ST_Init,              false, { NULL                   } },
+    { "AM_Init",              AM_Init,              false, { "I_GenerateTintTables" } },
+    { "C_Init",               C_Init,               false, { NULL                   } }
+};
+
+static void D_InitSubsystems(void)
+{
+    I_RunTasks(startuptasks, arrlen(startuptasks));
+
+    if (devparm)
+    {
+        int     i;
+
+        for (i = 0; i < (int)arrlen(startuptasks); ++i)
+            C_Output("<b>%s()</b> took %sms%s.", startuptasks[i].name,
+                striptrailingzero(startuptasks[i].time / 1000.0f, 1),
+                (startuptasks[i].onworker ? " on a worker thread" : ""));
+    }
+}
+
 //
 // D_DoomMainSetup
 //
@@ -1574,6 +1653,118 @@ static void D_DoomMainSetup(void)
 
     devparm = M_CheckParm("-devparm");
 
+    p = M_CheckParmWithArgs("-seed", 1, 1);
+    if (p)
+    {
+        startseed = (unsigned int)strtoul(myargv[p + 1], NULL, 10);
+        C_Output("<b>-seed %s</b> was found on the command-line. The random number generator "
+            "will be seeded with %u at the start of each map.", myargv[p + 1], startseed);
+    }
+
+    p = M_CheckParm("-profile");
+    if (p)
+    {
+        char    filename[MAX_PATH];
+
+        if (p < myargc - 1 && myargv[p + 1][0] != '-')
+            M_StringCopy(filename, myargv[p + 1], sizeof(filename));
+        else
+        {
+            const char  *appdatafolder = M_GetAppDataFolder();
+
+            M_MakeDirectory(appdatafolder);
+            M_snprintf(filename, sizeof(filename), "%s"DIR_SEPARATOR_S"profile.json",
+                appdatafolder);
+        }
+
+        if (M_OpenProfileTrace(filename))
+            C_Output("<b>-profile</b> was found on the command-line. A trace of each frame will "
+                "be written to <b>%s</b>.", filename);
+        else
+            C_Warning("<b>%s</b> couldn't be opened for profiling.", filename);
+    }
+
+    p = M_CheckParm("-nodraw");
+    if (p)
+    {
+        nodraw = true;
+
+        if (p < myargc - 1 && myargv[p + 1][0] != '-')
+            nodrawtics = MAX(1, atoi(myargv[p + 1]));
+
+        // no window or sound is needed
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+        C_Output("<b>-nodraw</b> was found on the command-line. <b>%s</b> tics will be run "
+            "without drawing anything.", commify(nodrawtics));
+
+        p = M_CheckParmWithArgs("-ticcmds", 1, 1);
+        if (p)
+        {
+            if (D_LoadTicCmdScript(myargv[p + 1]))
+                C_Output("The player will be controlled using <b>%s</b>.", myargv[p + 1]);
+            else
+                C_Warning("<b>%s</b> couldn't be loaded.", myargv[p + 1]);
+        }
+
+        p = M_CheckParmsWithArgs("-recordframes", "-checkframes", 1, 1);
+        if (p)
+        {
+            dboolean    record = M_StringCompare(myargv[p], "-recordframes");
+            int         interval = TICRATE;
+
+            if (record && p < myargc - 2 && myargv[p + 2][0] != '-')
+                interval = atoi(myargv[p + 2]);
+
+            if (D_OpenFrameChecksums(myargv[p + 1], record, interval))
+            {
+                // the same seed must be used each time for the frames to match
+                if (!startseed)
+                    startseed = 1;
+
+                C_Output("<b>%s</b> was found on the command-line. Checksums of frames will be "
+                    "%s <b>%s</b>.", myargv[p], (record ? "saved to" : "checked against"),
+                    myargv[p + 1]);
+            }
+            else
+                C_Warning("<b>%s</b> couldn't be opened.", myargv[p + 1]);
+        }
+    }
+
+    p = M_CheckParm("-stressarena");
+    if (p)
+    {
+        stressmode = STRESS_ARENA;
+
+        if (p < myargc - 1 && myargv[p + 1][0] != '-')
+            stressmonsters = atoi(myargv[p + 1]);
+    }
+    else if ((p = M_CheckParm("-stressmaze")))
+    {
+        stressmode = STRESS_MAZE;
+        stressmonsters = 1000;
+
+        if (p < myargc - 1 && myargv[p + 1][0] != '-')
+        {
+            stresssectors = atoi(myargv[p + 1]);
+
+            if (p < myargc - 2 && myargv[p + 2][0] != '-')
+                stressmonsters = atoi(myargv[p + 2]);
+        }
+    }
+
+    if (stressmode != STRESS_NONE)
+    {
+        p = M_CheckParmWithArgs("-stresstics", 1, 1);
+        if (p)
+            stresstics = MAX(1, atoi(myargv[p + 1]));
+
+        // no window or sound is needed
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    }
+
     // turbo option
     p = M_CheckParm("-turbo");
     if (p)
@@ -1708,6 +1899,8 @@ static void D_DoomMainSetup(void)
     // Generate the WAD hash table. Speed things up a bit.
     W_GenerateHashTable();
 
+    M_OpenStartupCache();
+
     I_InitGamepad();
 
     I_InitGraphics();
@@ -1895,21 +2088,9 @@ static void D_DoomMainSetup(void)
     P_BloodSplatSpawner = (r_blood == r_blood_none || !r_bloodsplats_max ?
         P_NullBloodSplatSpawner : P_SpawnBloodSplat);
 
-    M_Init();
+    D_InitSubsystems();
 
-    R_Init();
-
-    P_Init();
-
-    S_Init((int)(sfxVolume * 127.0f / 15.0f), (int)(musicVolume * 127.0f / 15.0f));
-
-    HU_Init();
-
-    ST_Init();
-
-    AM_Init();
-
-    C_Init();
+    M_CloseStartupCache();
 
     if (startloadgame >= 0)
     {
@@ -1920,16 +2101,52 @@ static void D_DoomMainSetup(void)
         G_LoadGame(P_SaveGameFile(startloadgame));
     }
 
-    splashlump = W_CacheLumpName("SPLASH", PU_CACHE);
-    splashpal = W_CacheLumpName("SPLSHPAL", PU_CACHE);
+    splashlump = W_CacheLumpName("SPLASH", PU_STATIC);
+    splashpal = W_CacheLumpName("SPLSHPAL", PU_STATIC);
     titlelump = W_CacheLumpName((TITLEPIC ? "TITLEPIC" : (DMENUPIC ? "DMENUPIC" : "INTERPIC")),
-        PU_CACHE);
-    creditlump = W_CacheLumpName("CREDIT", PU_CACHE);
-    playpal = W_CacheLumpName("PLAYPAL", PU_CACHE);
+        PU_STATIC);
+    creditlump = W_CacheLumpName("CREDIT", PU_STATIC);
+    playpal = W_CacheLumpName("PLAYPAL", PU_STATIC);
+
+    p = M_CheckParm("-benchmaps");
+    if (p)
+    {
+        char    filename[MAX_PATH];
+
+        if (p < myargc - 1 && myargv[p + 1][0] != '-')
+            M_StringCopy(filename, myargv[p + 1], sizeof(filename));
+        else
+        {
+            const char  *appdatafolder = M_GetAppDataFolder();
+
+            M_MakeDirectory(appdatafolder);
+            M_snprintf(filename, sizeof(filename), "%s"DIR_SEPARATOR_S"benchmaps.csv",
+                appdatafolder);
+        }
+
+        C_Output("<b>-benchmaps</b> was found on the command-line. Every map will be loaded, "
+            "and how long each took will be saved to <b>%s</b>.", filename);
+
+        if (G_BenchmarkMaps(filename) < 0)
+            C_Warning("<b>%s</b> couldn't be saved.", filename);
+
+        I_Quit(false);
+    }
+
+    if (stressmode != STRESS_NONE)
+    {
+        C_Output("<b>%s</b> was found on the command-line. A map will be generated and run for "
+            "<b>%s</b> tics.", (stressmode == STRESS_ARENA ? "-stressarena" : "-stressmaze"),
+            commify(stresstics));
+
+        P_RunStressTest();
+
+        I_Quit(false);
+    }
 
     if (gameaction != ga_loadgame)
     {
-        if (autostart)
+        if (autostart || nodraw)
         {
             I_InitKeyboard();
             if (alwaysrun)
@@ -1970,5 +2187,8 @@ void D_DoomMain(void)
 {
     D_DoomMainSetup();          // CPhipps - setup out of main execution stack
 
-    D_DoomLoop();               // never returns
+    if (nodraw)
+        D_RunHeadless();        // never returns
+    else
+        D_DoomLoop();           // never returns
 }
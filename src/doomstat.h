@@ -215,5 +215,6 @@ extern int              gp_sensitivity;
 extern int              skyflatnum;
 
 extern ticcmd_t         netcmds[BACKUPTICS];
+extern int              maketic;
 
 #endif
@@ -633,7 +633,7 @@ static dboolean F_CastResponder(event_t *ev)
     // go into death frame
     castdeath = true;
     if (r_corpses_mirrored && type != MT_CHAINGUY && type != MT_CYBORG)
-        castdeathflip = rand() & 1;
+        castdeathflip = M_FXRandom() & 1;
     caststate = &states[mobjinfo[type].deathstate];
     casttics = caststate->tics;
     if (casttics == -1 && caststate->action == A_RandomJump)
@@ -38,6 +38,7 @@
 
 #include "i_video.h"
 #include "f_wipe.h"
+#include "m_random.h"
 #include "v_video.h"
 #include "z_zone.h"
 
@@ -83,9 +84,9 @@ dboolean wipe_initMelt(void)
     // setup initial column positions
     // (y < 0 => not ready to scroll yet)
     y = Z_Malloc(SCREENWIDTH * sizeof(int), PU_STATIC, NULL);
-    y[0] = y[1] = -(rand() % 16);
+    y[0] = y[1] = -(M_FXRandom() % 16);
     for (i = 2; i < SCREENWIDTH - 1; i += 2)
-        y[i] = y[i + 1] = BETWEEN(-15, y[i - 1] + (rand() % 3) - 1, 0);
+        y[i] = y[i + 1] = BETWEEN(-15, y[i - 1] + (M_FXRandom() % 3) - 1, 0);
 
     return false;
 }
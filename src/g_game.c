@@ -52,6 +52,7 @@
 #include "i_timer.h"
 #include "m_menu.h"
 #include "m_misc.h"
+#include "m_profile.h"
 #include "m_random.h"
 #include "p_local.h"
 #include "p_saveg.h"
@@ -177,6 +178,11 @@ dboolean        skipaction;
 int             mousex;
 int             mousey;
 
+// the part of the angleturn of each ticcmd in netcmds[] that came from the
+// mouse, and of the last one that G_Ticker ran
+static int      mouseturns[BACKUPTICS];
+static int      lastmouseturn;
+
 dboolean        m_doubleclick_use = m_doubleclick_use_default;
 
 static int      dclicktime;
@@ -435,6 +441,8 @@ void G_BuildTiccmd(ticcmd_t *cmd)
     else
         cmd->angleturn -= mousex * 0x8;
 
+    mouseturns[maketic % BACKUPTICS] = (strafe ? 0 : -mousex * 0x8);
+
     mousex = 0;
     mousey = 0;
 
@@ -933,6 +941,8 @@ void G_Ticker(void)
     // and build new consistency check
     cmd = &player->cmd;
     memcpy(cmd, &netcmds[gametic % BACKUPTICS], sizeof(ticcmd_t));
+    lastmouseturn = mouseturns[gametic % BACKUPTICS];
+    mouseturns[gametic % BACKUPTICS] = 0;
 
     // check for special buttons
     if (player->cmd.buttons & BT_SPECIAL)
@@ -988,7 +998,9 @@ void G_Ticker(void)
     switch (gamestate)
     {
         case GS_LEVEL:
+            PROFILE_BEGIN(PROF_P_TICKER);
             P_Ticker();
+            PROFILE_END(PROF_P_TICKER);
             ST_Ticker();
             AM_Ticker();
             HU_Ticker();
@@ -1406,7 +1418,8 @@ void G_LoadGame(char *name)
 
 void G_DoLoadGame(void)
 {
-    int savedleveltime;
+    int                 savedleveltime;
+    unsigned int        savedrndseed;
 
     I_SetPalette(W_CacheLumpName("PLAYPAL", PU_CACHE));
 
@@ -1425,11 +1438,13 @@ void G_DoLoadGame(void)
     }
 
     savedleveltime = leveltime;
+    savedrndseed = rndseed;
 
     // load a base level
     G_InitNew(gameskill, gameepisode, gamemap);
 
     leveltime = savedleveltime;
+    M_Seed(savedrndseed);
 
     // unarchive all the modifications
     P_UnArchivePlayers();
@@ -1698,3 +1713,119 @@ void G_InitNew(skill_t skill, int ep, int map)
 
     G_DoLoadLevel();
 }
+
+//
+// G_GetLastMouseTurn
+// Returns how far the mouse turned the player in the last ticcmd that
+// G_Ticker ran.
+//
+angle_t G_GetLastMouseTurn(void)
+{
+    return ((angle_t)lastmouseturn << FRACBITS);
+}
+
+//
+// G_GetLatchedTurn
+// Returns how far the mouse has turned the player that hasn't been run by
+// G_Ticker yet. That is the turn in any ticcmds built but not yet run, and
+// any mouse movement since the last one was built, which is added to the
+// next ticcmd as usual. R_SetupFrame can show it straight away.
+//
+angle_t G_GetLatchedTurn(void)
+{
+    int turn = 0;
+    int i;
+
+    for (i = gametic; i < maketic; i++)
+        turn += mouseturns[i % BACKUPTICS];
+
+    if (!gamekeydown[key_strafe] && !mousebuttons[mousebstrafe]
+        && (!automapactive || am_followmode))
+        turn -= (I_GetLatchedMouseX() * m_sensitivity / 10) * 0x8;
+
+    return ((angle_t)turn << FRACBITS);
+}
+
+//
+// G_BenchmarkMaps
+// Loads every map in the loaded IWAD and PWADs, and writes how long each
+// phase of P_SetupLevel took, how much memory was used and how many of
+// each object there are to a CSV file. Returns the number of maps loaded.
+//
+int G_BenchmarkMaps(char *filename)
+{
+    FILE        *file = fopen(filename, "wt");
+    int         count = 0;
+    int         ep;
+    int         lastep = (gamemode == commercial || gamemode == shareware ? 1 :
+                    (gamemode == retail ? 4 : 3));
+    int         lastmap = (gamemode == commercial ? 99 : 9);
+    uint64_t    slowest = 0;
+    char        slowestmap[6] = "";
+    int         i;
+
+    if (!file)
+        return -1;
+
+    fputs("map,total", file);
+    for (i = 0; i < NUMSETUPPHASES; ++i)
+        fprintf(file, ",%s", setupphasenames[i]);
+    fputs(",other,zone bytes,level bytes,vertices,sectors,lines,sides,segs,subsectors,nodes,"
+        "things,mobjs\n", file);
+
+    for (ep = 1; ep <= lastep; ++ep)
+    {
+        int map;
+
+        for (map = 1; map <= lastmap; ++map)
+        {
+            char        lumpname[6];
+            uint64_t    phases = 0;
+            int         mobjs = 0;
+            thinker_t   *th;
+
+            if (gamemode == commercial)
+                M_snprintf(lumpname, sizeof(lumpname), "MAP%02i", map);
+            else
+                M_snprintf(lumpname, sizeof(lumpname), "E%iM%i", ep, map);
+
+            if (W_CheckNumForName(lumpname) < 0)
+                continue;
+
+            G_InitNew(startskill, ep, map);
+
+            for (th = thinkerclasscap[th_mobj].cnext; th != &thinkerclasscap[th_mobj];
+                th = th->cnext)
+                ++mobjs;
+
+            fprintf(file, "%s,%.3f", lumpname, setuptotaltime / 1000.0);
+            for (i = 0; i < NUMSETUPPHASES; ++i)
+            {
+                fprintf(file, ",%.3f", setuptimes[i] / 1000.0);
+                phases += setuptimes[i];
+            }
+            fprintf(file, ",%.3f,%u,%u,%i,%i,%i,%i,%i,%i,%i,%i,%i\n",
+                (setuptotaltime > phases ? setuptotaltime - phases : 0) / 1000.0,
+                (unsigned int)zonetotalstats.bytes,
+                (unsigned int)(zonetagstats[PU_LEVEL].bytes + zonetagstats[PU_LEVSPEC].bytes),
+                numvertexes, numsectors, numlines, numsides, numsegs, numsubsectors, numnodes,
+                numthings, mobjs);
+
+            if (setuptotaltime > slowest)
+            {
+                slowest = setuptotaltime;
+                M_StringCopy(slowestmap, lumpname, sizeof(slowestmap));
+            }
+
+            ++count;
+        }
+    }
+
+    fclose(file);
+
+    if (count)
+        C_Output("<b>%s</b> was the slowest map to load, taking <b>%.2f</b> milliseconds.",
+            slowestmap, slowest / 1000.0);
+
+    return count;
+}
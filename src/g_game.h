@@ -55,6 +55,13 @@ void G_DeferredInitNew(skill_t skill, int ep, int map);
 
 void G_DeferredLoadLevel(skill_t skill, int ep, int map); // [BH]
 
+// Mouse movement for R_SetupFrame to show before the next tic is run.
+angle_t G_GetLastMouseTurn(void);
+angle_t G_GetLatchedTurn(void);
+
+// Loads every map in turn, timing each phase of P_SetupLevel.
+int G_BenchmarkMaps(char *filename);
+
 // Can be called by the startup code or M_Responder,
 // calls P_SetupLevel.
 void G_LoadGame(char *name);
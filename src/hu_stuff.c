@@ -151,7 +151,7 @@ patch_t *HU_LoadHUDAmmoPatch(int ammopicnum)
 
     if ((mobjinfo[ammopic[ammopicnum].mobjnum].flags & MF_SPECIAL)
         && (lump = W_CheckNumForName(ammopic[ammopicnum].patchname)) >= 0)
-        return W_CacheLumpNum(lump, PU_CACHE);
+        return W_CacheLumpNum(lump, PU_STATIC);
     else
         return NULL;
 }
@@ -161,9 +161,9 @@ patch_t *HU_LoadHUDKeyPatch(int keypicnum)
     int lump;
 
     if (dehacked && (lump = W_CheckNumForName(keypic[keypicnum].patchnamea)) >= 0)
-        return W_CacheLumpNum(lump, PU_CACHE);
+        return W_CacheLumpNum(lump, PU_STATIC);
     else if ((lump = W_CheckNumForName(keypic[keypicnum].patchnameb)) >= 0)
-        return W_CacheLumpNum(lump, PU_CACHE);
+        return W_CacheLumpNum(lump, PU_STATIC);
     else
         return NULL;
 }
@@ -208,15 +208,15 @@ void HU_Init(void)
     tempscreen = Z_Malloc(SCREENWIDTH * SCREENHEIGHT, PU_STATIC, NULL);
 
     if ((lump = W_CheckNumForName("MEDIA0")) >= 0)
-        healthpatch = W_CacheLumpNum(lump, PU_CACHE);
+        healthpatch = W_CacheLumpNum(lump, PU_STATIC);
     if ((lump = W_CheckNumForName("PSTRA0")) >= 0)
-        berserkpatch = W_CacheLumpNum(lump, PU_CACHE);
+        berserkpatch = W_CacheLumpNum(lump, PU_STATIC);
     else
         berserkpatch = healthpatch;
     if ((lump = W_CheckNumForName("ARM1A0")) >= 0)
-        greenarmorpatch = W_CacheLumpNum(lump, PU_CACHE);
+        greenarmorpatch = W_CacheLumpNum(lump, PU_STATIC);
     if ((lump = W_CheckNumForName("ARM2A0")) >= 0)
-        bluearmorpatch = W_CacheLumpNum(lump, PU_CACHE);
+        bluearmorpatch = W_CacheLumpNum(lump, PU_STATIC);
 
     ammopic[am_clip].patch = HU_LoadHUDAmmoPatch(am_clip);
     ammopic[am_shell].patch = HU_LoadHUDAmmoPatch(am_shell);
@@ -235,7 +235,7 @@ void HU_Init(void)
     }
 
     if ((lump = W_CheckNumForName("STDISK")) >= 0)
-        stdisk = W_CacheLumpNum(lump, PU_CACHE);
+        stdisk = W_CacheLumpNum(lump, PU_STATIC);
 
     s_STSTR_BEHOLD2 = M_StringCompare(s_STSTR_BEHOLD, STSTR_BEHOLD2);
 
@@ -610,16 +610,16 @@ void HU_AltInit(void)
         altweapon[i] = W_CacheLumpName(buffer, PU_STATIC);
     }
 
-    altleftpatch = W_CacheLumpName("DRHUDL", PU_CACHE);
-    altarmpatch = W_CacheLumpName("DRHUDARM", PU_CACHE);
-    altrightpatch = W_CacheLumpName("DRHUDR", PU_CACHE);
+    altleftpatch = W_CacheLumpName("DRHUDL", PU_STATIC);
+    altarmpatch = W_CacheLumpName("DRHUDARM", PU_STATIC);
+    altrightpatch = W_CacheLumpName("DRHUDR", PU_STATIC);
 
-    altendpatch = W_CacheLumpName("DRHUDE", PU_CACHE);
-    altmarkpatch = W_CacheLumpName("DRHUDI", PU_CACHE);
-    altmark2patch = W_CacheLumpName("DRHUDI_2", PU_CACHE);
+    altendpatch = W_CacheLumpName("DRHUDE", PU_STATIC);
+    altmarkpatch = W_CacheLumpName("DRHUDI", PU_STATIC);
+    altmark2patch = W_CacheLumpName("DRHUDI_2", PU_STATIC);
 
-    altkeypatch = W_CacheLumpName("DRHUDKEY", PU_CACHE);
-    altskullpatch = W_CacheLumpName("DRHUDSKU", PU_CACHE);
+    altkeypatch = W_CacheLumpName("DRHUDKEY", PU_STATIC);
+    altskullpatch = W_CacheLumpName("DRHUDSKU", PU_STATIC);
 
     for (i = 0; i < NUMCARDS; i++)
         altkeypics[i].color = nearestcolors[altkeypics[i].color];
@@ -36,8 +36,12 @@
 ========================================================================
 */
 
+#include "SDL.h"
+
 #include "i_colors.h"
 #include "m_fixed.h"
+#include "m_misc.h"
+#include "version.h"
 #include "w_wad.h"
 #include "z_zone.h"
 
@@ -212,9 +216,122 @@ void FindNearestColors(byte *palette)
             nearestcolors[i] = i;
 }
 
-static byte *GenerateTintTable(byte *palette, int percent, byte filter[PALETTESIZE], int colors)
+//
+// Nearest color lookup
+//
+// Every entry of a tint table needs the palette index nearest to a blended color. Rather than
+// search all 256 palette entries each time, RGB space is split into a grid of cells, and each
+// cell lists only those entries that can be nearest to some color inside it. An entry is kept if
+// its distance to the cell is no more than the smallest distance within which some other entry
+// covers the whole cell, so the result is always the same as a full search.
+//
+#define NEARESTCELLSHIFT        4
+#define NEARESTCELLSIZE         (1 << NEARESTCELLSHIFT)
+#define NEARESTCELLS            (PALETTESIZE / NEARESTCELLSIZE)
+
+typedef struct
+{
+    int         first;
+    int         count;
+} nearestcell_t;
+
+static nearestcell_t    nearestcells[NEARESTCELLS * NEARESTCELLS * NEARESTCELLS];
+static byte             *nearestcandidates;
+
+static int DistanceToCell(int color, int lo, dboolean farthest)
+{
+    int hi = lo + NEARESTCELLSIZE - 1;
+
+    if (farthest)
+        return MAX(ABS(color - lo), ABS(color - hi));
+    else
+        return (color < lo ? lo - color : (color > hi ? color - hi : 0));
+}
+
+static void InitNearestCells(byte *palette)
+{
+    int cell;
+    int numcandidates = 0;
+    int maxcandidates = PALETTESIZE * 16;
+
+    nearestcandidates = malloc(maxcandidates);
+
+    for (cell = 0; cell < NEARESTCELLS * NEARESTCELLS * NEARESTCELLS; ++cell)
+    {
+        int     lo_r = (cell / (NEARESTCELLS * NEARESTCELLS)) * NEARESTCELLSIZE;
+        int     lo_g = ((cell / NEARESTCELLS) % NEARESTCELLS) * NEARESTCELLSIZE;
+        int     lo_b = (cell % NEARESTCELLS) * NEARESTCELLSIZE;
+        int     nearest[PALETTESIZE];
+        int     bound = INT_MAX;
+        int     i;
+
+        for (i = 0; i < PALETTESIZE; ++i)
+        {
+            byte        *color = palette + i * 3;
+            int         r = DistanceToCell(color[0], lo_r, true);
+            int         g = DistanceToCell(color[1], lo_g, true);
+            int         b = DistanceToCell(color[2], lo_b, true);
+
+            bound = MIN(bound, r * r + g * g + b * b);
+
+            r = DistanceToCell(color[0], lo_r, false);
+            g = DistanceToCell(color[1], lo_g, false);
+            b = DistanceToCell(color[2], lo_b, false);
+            nearest[i] = r * r + g * g + b * b;
+        }
+
+        if (numcandidates + PALETTESIZE > maxcandidates)
+            nearestcandidates = realloc(nearestcandidates, (maxcandidates *= 2));
+
+        nearestcells[cell].first = numcandidates;
+
+        for (i = 0; i < PALETTESIZE; ++i)
+            if (nearest[i] <= bound)
+                nearestcandidates[numcandidates++] = i;
+
+        nearestcells[cell].count = numcandidates - nearestcells[cell].first;
+    }
+}
+
+static void FreeNearestCells(void)
+{
+    free(nearestcandidates);
+    nearestcandidates = NULL;
+}
+
+static int FindNearestCellColor(byte *palette, int red, int green, int blue)
+{
+    nearestcell_t       *cell = &nearestcells[(((red >> NEARESTCELLSHIFT) * NEARESTCELLS
+                            + (green >> NEARESTCELLSHIFT)) * NEARESTCELLS) + (blue >> NEARESTCELLSHIFT)];
+    byte                *candidate = nearestcandidates + cell->first;
+    int                 best_difference = INT_MAX;
+    int                 best_color = 0;
+    int                 i;
+
+    for (i = 0; i < cell->count; ++i)
+    {
+        int     index = candidate[i];
+        byte    *color = palette + index * 3;
+        int     r = red - color[0];
+        int     g = green - color[1];
+        int     b = blue - color[2];
+        int     difference = r * r + g * g + b * b;
+
+        if (difference < best_difference)
+        {
+            if (!difference)
+                return index;
+
+            best_color = index;
+            best_difference = difference;
+        }
+    }
+    return best_color;
+}
+
+static void GenerateTintTable(byte *result, byte *palette, int percent, byte filter[PALETTESIZE],
+    int colors)
 {
-    byte        *result = Z_Malloc(PALETTESIZE * PALETTESIZE, PU_STATIC, NULL);
     int         foreground, background;
 
     for (foreground = 0; foreground < PALETTESIZE; ++foreground)
@@ -248,44 +365,201 @@ static byte *GenerateTintTable(byte *palette, int percent, byte filter[PALETTESI
                     g = ((int)color1[1] * percent + (int)color2[1] * (100 - percent)) / 100;
                     b = ((int)color1[2] * percent + (int)color2[2] * (100 - percent)) / 100;
                 }
-                *(result + (background << 8) + foreground) = FindNearestColor(palette, r, g, b);
+                *(result + (background << 8) + foreground) = FindNearestCellColor(palette, r, g, b);
             }
         }
         else
             for (background = 0; background < PALETTESIZE; ++background)
                 *(result + (background << 8) + foreground) = foreground;
     }
+}
+
+//
+// Tint table generation
+//
+// The tables are independent of each other, so they are shared out between one thread per
+// logical core. Each thread takes the next table not yet claimed until none are left.
+//
+typedef struct
+{
+    byte        **table;
+    int         percent;
+    int         colors;
+} tinttable_t;
 
+static tinttable_t tinttables[] =
+{
+    { &tinttab,           ADDITIVE, ALL                      },
+    { &tinttab20,         20,       ALL                      },
+    { &tinttab25,         25,       ALL                      },
+    { &tinttab33,         33,       ALL                      },
+    { &tinttab40,         40,       ALL                      },
+    { &tinttab50,         50,       ALL                      },
+    { &tinttab60,         60,       ALL                      },
+    { &tinttab66,         66,       ALL                      },
+    { &tinttab75,         75,       ALL                      },
+    { &tinttab80,         80,       ALL                      },
+    { &tinttabred,        ADDITIVE, REDS                     },
+    { &tinttabredwhite1,  ADDITIVE, (REDS | WHITES)          },
+    { &tinttabredwhite2,  ADDITIVE, (REDS | WHITES | EXTRAS) },
+    { &tinttabgreen,      ADDITIVE, GREENS                   },
+    { &tinttabblue,       ADDITIVE, BLUES                    },
+    { &tinttabred33,      33,       REDS                     },
+    { &tinttabredwhite50, 50,       (REDS | WHITES)          },
+    { &tinttabgreen33,    33,       GREENS                   },
+    { &tinttabblue25,     25,       BLUES                    }
+};
+
+#define NUMTINTTABLES   arrlen(tinttables)
+#define MAXTINTTHREADS  16
+
+static byte             tintpalette[PALETTESIZE * 3];
+static SDL_atomic_t     nexttinttable;
+
+static int SDLCALL GenerateTintTables(void *data)
+{
+    int i;
+
+    while ((i = SDL_AtomicAdd(&nexttinttable, 1)) < (int)NUMTINTTABLES)
+        GenerateTintTable(*tinttables[i].table, tintpalette, tinttables[i].percent, general,
+            tinttables[i].colors);
+
+    return 0;
+}
+
+//
+// Tint table cache
+//
+// Generated tables are written to a file in the app data folder, headed by a hash of the
+// palette they were generated from. Later launches with the same PLAYPAL read them back
+// instead of generating them again.
+//
+typedef struct
+{
+    char        version[32];
+    uint32_t    palettehash;
+    uint32_t    size;
+} tintcacheheader_t;
+
+static char             *tintcachefile;
+
+static void GetTintCacheHeader(tintcacheheader_t *header, byte *palette)
+{
+    uint32_t    hash = 2166136261u;
+    int         i;
+
+    for (i = 0; i < PALETTESIZE * 3; ++i)
+        hash = (hash ^ palette[i]) * 16777619u;
+
+    for (i = 0; i < PALETTESIZE; ++i)
+        hash = (hash ^ general[i]) * 16777619u;
+
+    memset(header, 0, sizeof(*header));
+    M_StringCopy(header->version, PACKAGE_TINTCACHEVERSIONSTRING, sizeof(header->version));
+    header->palettehash = hash;
+    header->size = PALETTESIZE * PALETTESIZE * NUMTINTTABLES;
+}
+
+static dboolean LoadTintCache(byte *palette)
+{
+    FILE                *handle = fopen(tintcachefile, "rb");
+    tintcacheheader_t   header;
+    tintcacheheader_t   expected;
+    dboolean            result = false;
+
+    if (!handle)
+        return false;
+
+    GetTintCacheHeader(&expected, palette);
+
+    if (fread(&header, sizeof(header), 1, handle) == 1 && !memcmp(&header, &expected, sizeof(header)))
+    {
+        unsigned int    i;
+
+        result = true;
+
+        for (i = 0; i < NUMTINTTABLES; ++i)
+            if (fread(*tinttables[i].table, PALETTESIZE * PALETTESIZE, 1, handle) != 1)
+            {
+                result = false;
+                break;
+            }
+    }
+
+    fclose(handle);
     return result;
 }
 
+static void SaveTintCache(byte *palette)
+{
+    FILE                *handle = fopen(tintcachefile, "wb");
+    tintcacheheader_t   header;
+    dboolean            result;
+    unsigned int        i;
+
+    if (!handle)
+        return;
+
+    GetTintCacheHeader(&header, palette);
+    result = (fwrite(&header, sizeof(header), 1, handle) == 1);
+
+    for (i = 0; i < NUMTINTTABLES && result; ++i)
+        result = (fwrite(*tinttables[i].table, PALETTESIZE * PALETTESIZE, 1, handle) == 1);
+
+    fclose(handle);
+
+    // Don't leave a partial cache behind for the next launch
+    if (!result)
+        remove(tintcachefile);
+}
+
+//
+// I_InitTintTables
+//
+// Allocates the tint tables. They are filled in by I_GenerateTintTables, which
+// may be run on a worker thread, so the palette is copied rather than kept.
+//
 void I_InitTintTables(byte *palette)
 {
-    lumpindex_t lump;
+    lumpindex_t         lump;
+    unsigned int        i;
 
-    tinttab = GenerateTintTable(palette, ADDITIVE, general, ALL);
+    for (i = 0; i < NUMTINTTABLES; ++i)
+        *tinttables[i].table = Z_Malloc(PALETTESIZE * PALETTESIZE, PU_STATIC, NULL);
 
-    tinttab20 = GenerateTintTable(palette, 20, general, ALL);
-    tinttab25 = GenerateTintTable(palette, 25, general, ALL);
-    tinttab33 = GenerateTintTable(palette, 33, general, ALL);
-    tinttab40 = GenerateTintTable(palette, 40, general, ALL);
-    tinttab50 = GenerateTintTable(palette, 50, general, ALL);
-    tinttab60 = GenerateTintTable(palette, 60, general, ALL);
-    tinttab66 = GenerateTintTable(palette, 66, general, ALL);
-    tinttab75 = GenerateTintTable(palette, 75, general, ALL);
-    tinttab80 = GenerateTintTable(palette, 80, general, ALL);
+    memcpy(tintpalette, palette, sizeof(tintpalette));
+    tintcachefile = M_StringJoin(M_GetAppDataFolder(), DIR_SEPARATOR_S, PACKAGE_TINTCACHE, NULL);
 
     tranmap = ((lump = W_CheckNumForName("TRANMAP")) != -1 ? W_CacheLumpNum(lump, PU_STATIC) :
         tinttab50);
+}
+
+//
+// I_GenerateTintTables
+//
+void I_GenerateTintTables(void)
+{
+    if (!LoadTintCache(tintpalette))
+    {
+        SDL_Thread      *threads[MAXTINTTHREADS];
+        int             numthreads = BETWEEN(1, SDL_GetCPUCount(), MAXTINTTHREADS);
+        int             i;
+
+        InitNearestCells(tintpalette);
+
+        SDL_AtomicSet(&nexttinttable, 0);
 
-    tinttabred = GenerateTintTable(palette, ADDITIVE, general, REDS);
-    tinttabredwhite1 = GenerateTintTable(palette, ADDITIVE, general, (REDS | WHITES));
-    tinttabredwhite2 = GenerateTintTable(palette, ADDITIVE, general, (REDS | WHITES | EXTRAS));
-    tinttabgreen = GenerateTintTable(palette, ADDITIVE, general, GREENS);
-    tinttabblue = GenerateTintTable(palette, ADDITIVE, general, BLUES);
+        // The calling thread takes its share too
+        for (i = 1; i < numthreads; ++i)
+            threads[i] = SDL_CreateThread(GenerateTintTables, "GenerateTintTables", NULL);
 
-    tinttabred33 = GenerateTintTable(palette, 33, general, REDS);
-    tinttabredwhite50 = GenerateTintTable(palette, 50, general, (REDS | WHITES));
-    tinttabgreen33 = GenerateTintTable(palette, 33, general, GREENS);
-    tinttabblue25 = GenerateTintTable(palette, 25, general, BLUES);
+        GenerateTintTables(NULL);
+
+        for (i = 1; i < numthreads; ++i)
+            if (threads[i])
+                SDL_WaitThread(threads[i], NULL);
+
+        FreeNearestCells();
+        SaveTintCache(tintpalette);
+    }
 }
@@ -46,6 +46,7 @@
 extern byte     nearestcolors[PALETTESIZE];
 
 void I_InitTintTables(byte *palette);
+void I_GenerateTintTables(void);
 void FindNearestColors(byte *palette);
 
 #endif
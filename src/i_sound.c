@@ -394,6 +394,9 @@ static dboolean CacheSFX(sfxinfo_t *sfxinfo)
     byte                *data = W_CacheLumpNum(lumpnum, PU_STATIC);
     unsigned int        lumplen = W_LumpLength(lumpnum);
 
+    if (!W_IsMappedLump(lumpnum))
+        Z_ChangeOwner(data, ZO_SOUND);
+
     // Check the header, and ensure this is a valid sound
     if (lumplen < 8 || data[0] != 0x03 || data[1] != 0x00)
         return false;   // Invalid sound
@@ -605,18 +608,16 @@ static int GetSliceSize(void)
     return 1024;
 }
 
-dboolean I_InitSound(void)
+//
+// I_CheckSoundVersion
+//
+// Must be called on the main thread before I_InitSound, which may then be
+// called from a worker thread.
+//
+void I_CheckSoundVersion(void)
 {
-    int                 i;
     const SDL_version   *linked = Mix_Linked_Version();
 
-    // No sounds yet
-    for (i = 0; i < NUM_CHANNELS; ++i)
-        channels_playing[i] = NULL;
-
-    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
-        return false;
-
     if (linked->major != SDL_MIXER_MAJOR_VERSION || linked->minor != SDL_MIXER_MINOR_VERSION)
         I_Error("The wrong version of sdl2_mixer.dll was found. "PACKAGE_NAME" requires "
             "v%i.%i.%i, not v%i.%i.%i.", linked->major, linked->minor, linked->patch,
@@ -626,6 +627,18 @@ dboolean I_InitSound(void)
         C_Warning("The wrong version of sdl2_mixer.dll was found. "PACKAGE_NAME" requires "
             "v%i.%i.%i, not v%i.%i.%i.", linked->major, linked->minor, linked->patch,
             SDL_MIXER_MAJOR_VERSION, SDL_MIXER_MINOR_VERSION, SDL_MIXER_PATCHLEVEL);
+}
+
+dboolean I_InitSound(void)
+{
+    int                 i;
+
+    // No sounds yet
+    for (i = 0; i < NUM_CHANNELS; ++i)
+        channels_playing[i] = NULL;
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0)
+        return false;
 
     if (Mix_OpenAudio(SAMPLERATE, AUDIO_S16SYS, 2, GetSliceSize()) < 0)
         return false;
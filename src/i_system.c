@@ -50,6 +50,7 @@ void I_ShutdownWindows32(void);
 #include "i_timer.h"
 #include "m_config.h"
 #include "m_misc.h"
+#include "m_profile.h"
 #include "s_sound.h"
 #include "version.h"
 
@@ -209,6 +210,8 @@ void I_PrintSystemInfo(void)
 //
 void I_Quit(dboolean shutdown)
 {
+    M_CloseProfileTrace();
+
     if (shutdown)
     {
         S_Shutdown();
@@ -0,0 +1,227 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include "SDL.h"
+
+#include "i_system.h"
+#include "i_tasks.h"
+#include "i_timer.h"
+#include "m_fixed.h"
+#include "m_misc.h"
+
+// A small scheduler for startup. Tasks are run in the order given, each one
+// once the tasks it depends on are done. The calling thread runs every task
+// that isn't marked as a worker task, and a pool of one thread per spare
+// logical core runs those that are. If the calling thread has nothing it can
+// run yet, it takes a worker task itself rather than wait.
+#define MAXTASKTHREADS  8
+
+static task_t           *tasks;
+static int              numtasks;
+
+static SDL_mutex        *tasklock;
+static SDL_cond         *taskdone;
+
+static task_t *I_FindTask(char *name)
+{
+    int i;
+
+    for (i = 0; i < numtasks; ++i)
+        if (M_StringCompare(tasks[i].name, name))
+            return &tasks[i];
+
+    return NULL;
+}
+
+static dboolean I_TaskIsReady(task_t *task)
+{
+    int i;
+
+    if (task->state != TASK_WAITING)
+        return false;
+
+    for (i = 0; i < MAXTASKDEPS && task->deps[i]; ++i)
+        if (I_FindTask(task->deps[i])->state != TASK_DONE)
+            return false;
+
+    return true;
+}
+
+// Must be called with tasklock held. Returns the next task the calling thread
+// may run, or NULL if there isn't one yet.
+static task_t *I_NextTask(dboolean mainthread)
+{
+    int i;
+
+    if (mainthread)
+        for (i = 0; i < numtasks; ++i)
+            if (!tasks[i].worker && I_TaskIsReady(&tasks[i]))
+                return &tasks[i];
+
+    for (i = 0; i < numtasks; ++i)
+        if (tasks[i].worker && I_TaskIsReady(&tasks[i]))
+            return &tasks[i];
+
+    return NULL;
+}
+
+static dboolean I_TasksLeft(dboolean mainthread)
+{
+    int i;
+
+    for (i = 0; i < numtasks; ++i)
+        if ((mainthread || tasks[i].worker) && tasks[i].state == TASK_WAITING)
+            return true;
+
+    return false;
+}
+
+// Runs a task with tasklock released
+static void I_RunTask(task_t *task, dboolean onworker)
+{
+    uint64_t    start;
+
+    task->state = TASK_RUNNING;
+    task->onworker = onworker;
+    SDL_UnlockMutex(tasklock);
+
+    start = I_GetTimeUS();
+    task->func();
+    task->time = I_GetTimeUS() - start;
+
+    SDL_LockMutex(tasklock);
+    task->state = TASK_DONE;
+    SDL_CondBroadcast(taskdone);
+}
+
+static int SDLCALL I_TaskWorker(void *data)
+{
+    SDL_LockMutex(tasklock);
+
+    while (I_TasksLeft(false))
+    {
+        task_t  *task = I_NextTask(false);
+
+        if (task)
+            I_RunTask(task, true);
+        else
+            SDL_CondWait(taskdone, tasklock);
+    }
+
+    SDL_UnlockMutex(tasklock);
+    return 0;
+}
+
+//
+// I_RunTasks
+//
+// Returns once every task is done. Each task's time in microseconds is left
+// in its time field.
+//
+void I_RunTasks(task_t *tasklist, int count)
+{
+    SDL_Thread  *threads[MAXTASKTHREADS];
+    int         numthreads = 0;
+    int         numworkertasks = 0;
+    int         i, j;
+
+    tasks = tasklist;
+    numtasks = count;
+
+    for (i = 0; i < numtasks; ++i)
+    {
+        tasks[i].state = TASK_WAITING;
+        tasks[i].time = 0;
+        tasks[i].onworker = false;
+
+        for (j = 0; j < MAXTASKDEPS && tasks[i].deps[j]; ++j)
+            if (!I_FindTask(tasks[i].deps[j]))
+                I_Error("I_RunTasks: %s depends on %s, which doesn't exist.", tasks[i].name,
+                    tasks[i].deps[j]);
+
+        if (tasks[i].worker)
+            numworkertasks++;
+    }
+
+    tasklock = SDL_CreateMutex();
+    taskdone = SDL_CreateCond();
+
+    if (numworkertasks)
+    {
+        int     maxthreads = BETWEEN(0, SDL_GetCPUCount() - 1, MAXTASKTHREADS);
+
+        while (numthreads < MIN(maxthreads, numworkertasks))
+        {
+            if (!(threads[numthreads] = SDL_CreateThread(I_TaskWorker, "I_TaskWorker", NULL)))
+                break;
+
+            numthreads++;
+        }
+    }
+
+    SDL_LockMutex(tasklock);
+
+    while (I_TasksLeft(true))
+    {
+        task_t  *task = I_NextTask(true);
+
+        if (task)
+            I_RunTask(task, false);
+        else
+        {
+            dboolean    running = false;
+
+            for (i = 0; i < numtasks; ++i)
+                if (tasks[i].state == TASK_RUNNING)
+                    running = true;
+
+            if (!running)
+                I_Error("I_RunTasks: The tasks depend on each other in a loop.");
+
+            SDL_CondWait(taskdone, tasklock);
+        }
+    }
+
+    SDL_UnlockMutex(tasklock);
+
+    for (i = 0; i < numthreads; ++i)
+        SDL_WaitThread(threads[i], NULL);
+
+    SDL_DestroyCond(taskdone);
+    SDL_DestroyMutex(tasklock);
+}
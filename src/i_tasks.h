@@ -0,0 +1,72 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#if !defined(__I_TASKS_H__)
+#define __I_TASKS_H__
+
+#include "doomtype.h"
+
+#define MAXTASKDEPS     4
+
+typedef enum
+{
+    TASK_WAITING,
+    TASK_RUNNING,
+    TASK_DONE
+} taskstate_t;
+
+typedef struct
+{
+    char                *name;
+    void                (*func)(void);
+
+    // May be run on a worker thread. Only set for tasks that don't touch the
+    // zone, the WADs or the console.
+    dboolean            worker;
+
+    // Names of the tasks that must be done before this one is started
+    char                *deps[MAXTASKDEPS];
+
+    taskstate_t         state;
+    uint64_t            time;
+    dboolean            onworker;
+} task_t;
+
+void I_RunTasks(task_t *tasks, int numtasks);
+
+#endif
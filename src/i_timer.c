@@ -37,15 +37,57 @@
 */
 
 #include "doomdef.h"
+#include "m_fixed.h"
 #include "SDL.h"
 
+static uint64_t basecounter;
+static uint64_t frequency;
+
+//
+// I_GetTimeNS
+// Returns time in nanoseconds from the high-resolution performance counter.
+// Every other timer is derived from this so tics, interpolation and the
+// profilers all agree.
+//
+uint64_t I_GetTimeNS(void)
+{
+    uint64_t    counter = SDL_GetPerformanceCounter();
+
+    if (!frequency)
+    {
+        frequency = SDL_GetPerformanceFrequency();
+        basecounter = counter;
+    }
+
+    counter -= basecounter;
+
+    // split the division so the multiplication can't overflow
+    return (counter / frequency * 1000000000 + counter % frequency * 1000000000 / frequency);
+}
+
 //
 // I_GetTime
 // returns time in 1/35th second tics
 //
 int I_GetTime(void)
 {
-    return SDL_GetTicks() * TICRATE / 1000;
+    return (int)(I_GetTimeNS() * TICRATE / 1000000000);
+}
+
+//
+// Returns how far into the current tic we are, from 0 to FRACUNIT - 1
+//
+int I_GetTimeFrac(void)
+{
+    return (int)(I_GetTimeNS() * TICRATE % 1000000000 * FRACUNIT / 1000000000);
+}
+
+//
+// Returns the number of nanoseconds until the next tic starts
+//
+uint64_t I_GetTimeToNextTic(void)
+{
+    return ((1000000000 - I_GetTimeNS() * TICRATE % 1000000000) / TICRATE);
 }
 
 //
@@ -53,7 +95,15 @@ int I_GetTime(void)
 //
 int I_GetTimeMS(void)
 {
-    return SDL_GetTicks();
+    return (int)(I_GetTimeNS() / 1000000);
+}
+
+//
+// Returns time in microseconds
+//
+uint64_t I_GetTimeUS(void)
+{
+    return (I_GetTimeNS() / 1000);
 }
 
 //
@@ -64,8 +114,28 @@ void I_Sleep(int ms)
     SDL_Delay(ms);
 }
 
+//
+// I_SleepUntil
+// Sleep until the given time in ns. The OS can only be relied upon to wake
+// us up within a couple of ms, so the last of the wait is spent yielding.
+//
+void I_SleepUntil(uint64_t ns)
+{
+    uint64_t    now;
+
+    while ((now = I_GetTimeNS()) < ns)
+    {
+        uint64_t        remaining = ns - now;
+
+        SDL_Delay(remaining > 2000000 ? (Uint32)(remaining / 1000000 - 1) : 0);
+    }
+}
+
 void I_InitTimer(void)
 {
     // initialize timer
     SDL_InitSubSystem(SDL_INIT_TIMER);
+
+    // start counting from 0
+    I_GetTimeNS();
 }
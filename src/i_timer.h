@@ -39,16 +39,33 @@
 #if !defined(__I_TIMER_H__)
 #define __I_TIMER_H__
 
+#include "doomtype.h"
+
 // Called by D_DoomLoop,
 // returns current time in tics.
 int I_GetTime(void);
 
+// returns how far into the current tic we are, as a fraction of FRACUNIT
+int I_GetTimeFrac(void);
+
+// returns the number of ns until the next tic starts
+uint64_t I_GetTimeToNextTic(void);
+
 // returns current time in ms
 int I_GetTimeMS(void);
 
+// returns current time in microseconds
+uint64_t I_GetTimeUS(void);
+
+// returns current time in nanoseconds
+uint64_t I_GetTimeNS(void);
+
 // Pause for a specified number of ms
 void I_Sleep(int ms);
 
+// Pause until the specified time in ns
+void I_SleepUntil(uint64_t ns);
+
 // Initialize timer
 void I_InitTimer(void);
 
@@ -43,6 +43,7 @@
 #include "i_colors.h"
 #include "i_gamepad.h"
 #include "i_system.h"
+#include "i_timer.h"
 #include "m_config.h"
 #include "m_menu.h"
 #include "m_misc.h"
@@ -68,6 +69,7 @@
                                     (__LINE__ - 1), leafname(__FILE__), SDL_GetError())
 
 // CVARs
+dboolean                m_latelatch = m_latelatch_default;
 dboolean                m_novertical = m_novertical_default;
 dboolean                vid_capfps = vid_capfps_default;
 int                     vid_display = vid_display_default;
@@ -75,6 +77,7 @@ int                     vid_display = vid_display_default;
 char                    *vid_driver = vid_driver_default;
 #endif
 dboolean                vid_fullscreen = vid_fullscreen_default;
+int                     vid_maxfps = vid_maxfps_default;
 int                     vid_motionblur = vid_motionblur_default;
 char                    *vid_scaleapi = vid_scaleapi_default;
 char                    *vid_scalefilter = vid_scalefilter_default;
@@ -176,6 +179,33 @@ void                    (*mapblitfunc)(void);
 
 int                     fps = 0;
 
+// time taken by each of the most recent frames, in microseconds
+uint32_t                frametimes[FRAMETIMES];
+unsigned int            frametimecount;
+static uint64_t         lastframetime;
+
+// mouse movement read since the last ticcmd was built
+static int              latchedmousex;
+static int              latchedmousey;
+
+// when the oldest mouse movement not yet shown arrived, and when the oldest
+// movement in the frame about to be shown arrived
+static uint64_t         mousearrivaltime;
+static uint64_t         mouseshowntime;
+
+// measuring the time from mouse movement to it being shown
+dboolean                mouselatency;
+unsigned int            mouselatencycount;
+uint64_t                mouselatencytotal;
+uint64_t                mouselatencymax;
+
+// frames shown after their deadline while vid_maxfps is set
+unsigned int            framesmissed;
+static uint64_t         framedeadline;
+static uint64_t         frameperiod;
+static uint64_t         framestart;
+static uint64_t         framecost;
+
 // Mouse acceleration
 //
 // This emulates some of the behavior of DOS mouse drivers by increasing
@@ -581,6 +611,63 @@ static void I_GetEvent(void)
     }
 }
 
+//
+// I_LatchMouse
+// Called just before each frame is rendered to read any mouse movement
+// since the last ticcmd was built, so it can be shown straight away. The
+// movement is still added to the next ticcmd by I_ReadMouse.
+//
+void I_LatchMouse(void)
+{
+    int x, y;
+
+    if (!(m_latelatch || mouselatency) || !m_sensitivity)
+        return;
+
+    SDL_PumpEvents();
+    SDL_GetRelativeMouseState(&x, &y);
+
+    if (x || y)
+    {
+        if (!mousearrivaltime)
+            mousearrivaltime = I_GetTimeNS();
+
+        latchedmousex += x;
+        latchedmousey += y;
+    }
+}
+
+//
+// I_GetMouseX
+// Returns the horizontal movement that the next ticcmd gets, once x has been
+// read. Acceleration is applied once to all of the movement since the last
+// ticcmd, latched or not, so what R_SetupFrame shows matches the ticcmd.
+//
+static int I_GetMouseX(int x)
+{
+    return AccelerateMouse(latchedmousex + x);
+}
+
+int I_GetLatchedMouseX(void)
+{
+    return I_GetMouseX(0);
+}
+
+//
+// I_MouseShown
+// Called once all the mouse movement so far will be shown in the next frame.
+//
+void I_MouseShown(void)
+{
+    if (mousearrivaltime)
+    {
+        if (!mouseshowntime)
+            mouseshowntime = mousearrivaltime;
+
+        mousearrivaltime = 0;
+    }
+}
+
 static void I_ReadMouse(void)
 {
     int         x, y;
@@ -588,11 +675,22 @@ static void I_ReadMouse(void)
 
     SDL_GetRelativeMouseState(&x, &y);
 
+    if ((x || y) && !mousearrivaltime)
+        mousearrivaltime = I_GetTimeNS();
+
+    ev.data2 = I_GetMouseX(x);
+    x += latchedmousex;
+    y += latchedmousey;
+    latchedmousex = 0;
+    latchedmousey = 0;
+
     if (x || y)
     {
+        // the movement will be shown once this ticcmd has been run
+        I_MouseShown();
+
         ev.type = ev_mouse;
         ev.data1 = mouse_button_state;
-        ev.data2 = AccelerateMouse(x);
         ev.data3 = (m_novertical ? 0 : -AccelerateMouse(y));
 
         D_PostEvent(&ev);
@@ -676,15 +774,15 @@ static void I_Blit_NearestLinear(void)
 }
 
 static int      frames = -1;
-static Uint32   starttime;
-static Uint32   currenttime;
+static int      starttime;
+static int      currenttime;
 
 static void I_Blit_ShowFPS(void)
 {
     UpdateGrab();
 
     ++frames;
-    currenttime = SDL_GetTicks();
+    currenttime = I_GetTimeMS();
     if (currenttime - starttime >= 1000)
     {
         fps = frames;
@@ -705,7 +803,7 @@ static void I_Blit_NearestLinear_ShowFPS(void)
     UpdateGrab();
 
     ++frames;
-    currenttime = SDL_GetTicks();
+    currenttime = I_GetTimeMS();
     if (currenttime - starttime >= 1000)
     {
         fps = frames;
@@ -762,7 +860,7 @@ static void I_Blit_ShowFPS_Shake(void)
     UpdateGrab();
 
     ++frames;
-    currenttime = SDL_GetTicks();
+    currenttime = I_GetTimeMS();
     if (currenttime - starttime >= 1000)
     {
         fps = frames;
@@ -786,7 +884,7 @@ static void I_Blit_NearestLinear_ShowFPS_Shake(void)
     UpdateGrab();
 
     ++frames;
-    currenttime = SDL_GetTicks();
+    currenttime = I_GetTimeMS();
     if (currenttime - starttime >= 1000)
     {
         fps = frames;
@@ -816,6 +914,174 @@ void I_UpdateBlitFunc(dboolean shake)
             (nearestlinear ? I_Blit_NearestLinear : I_Blit));
 }
 
+//
+// I_UpdateFrameTimes
+// Called after each frame is shown to record how long it took since the
+// previous one.
+//
+void I_UpdateFrameTimes(void)
+{
+    uint64_t    now = I_GetTimeUS();
+
+    if (mouseshowntime)
+    {
+        if (mouselatency)
+        {
+            uint64_t    latency = I_GetTimeNS() - mouseshowntime;
+
+            ++mouselatencycount;
+            mouselatencytotal += latency;
+            if (latency > mouselatencymax)
+                mouselatencymax = latency;
+        }
+
+        mouseshowntime = 0;
+    }
+
+    if (lastframetime)
+    {
+        uint64_t        frametime = now - lastframetime;
+
+        frametimes[frametimecount++ % FRAMETIMES] = (uint32_t)(frametime < 0xFFFFFFFF ?
+            frametime : 0xFFFFFFFF);
+    }
+
+    lastframetime = now;
+}
+
+void I_ResetFrameTimes(void)
+{
+    frametimecount = 0;
+    lastframetime = 0;
+    framesmissed = 0;
+}
+
+//
+// I_StartFrameLimiter
+// Called before each frame when vid_maxfps is set. Waits until there's
+// only enough time left to run tics and render before the frame's
+// deadline, based on how long recent frames took.
+//
+void I_StartFrameLimiter(void)
+{
+    uint64_t    now;
+
+    if (!vid_maxfps || vid_capfps)
+    {
+        framedeadline = 0;
+        return;
+    }
+
+    // vid_maxfps can be changed in the console while the frame is running, so
+    // I_EndFrameLimiter uses this period too
+    frameperiod = 1000000000 / vid_maxfps;
+    now = I_GetTimeNS();
+
+    // start again if this is the first frame or we've fallen too far behind
+    if (!framedeadline || now > framedeadline + frameperiod)
+        framedeadline = now + frameperiod;
+
+    if (framedeadline > now + framecost)
+        I_SleepUntil(framedeadline - framecost);
+
+    framestart = I_GetTimeNS();
+}
+
+//
+// I_EndFrameLimiter
+// Called once the frame has been shown.
+//
+void I_EndFrameLimiter(void)
+{
+    uint64_t    now;
+    uint64_t    cost;
+
+    if (!framedeadline)
+        return;
+
+    now = I_GetTimeNS();
+    cost = now - framestart;
+
+    // react quickly to slower frames but only slowly to faster ones
+    framecost = (cost > framecost ? cost : (framecost * 15 + cost) / 16);
+
+    if (now > framedeadline)
+        ++framesmissed;
+
+    framedeadline += frameperiod;
+}
+
+static int FrameTimeCompare(const void *a, const void *b)
+{
+    const uint32_t      x = *(const uint32_t *)a;
+    const uint32_t      y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+//
+// I_GetFrameTimeStats
+// Percentiles and averages are in milliseconds. The 1% and 0.1% lows are
+// the average FPS of the slowest 1% and 0.1% of frames.
+//
+void I_GetFrameTimeStats(frametimestats_t *stats)
+{
+    static uint32_t     sorted[FRAMETIMES];
+    unsigned int        count = (frametimecount < FRAMETIMES ? frametimecount : FRAMETIMES);
+    unsigned int        i;
+    unsigned int        n;
+    uint64_t            total = 0;
+
+    memset(stats, 0, sizeof(*stats));
+
+    if (!count)
+        return;
+
+    memcpy(sorted, frametimes, count * sizeof(uint32_t));
+    qsort(sorted, count, sizeof(uint32_t), FrameTimeCompare);
+
+    for (i = 0; i < count; ++i)
+        total += sorted[i];
+
+    stats->frames = count;
+    stats->average = total / 1000.0f / count;
+    stats->p50 = sorted[(count - 1) * 50 / 100] / 1000.0f;
+    stats->p95 = sorted[(count - 1) * 95 / 100] / 1000.0f;
+    stats->p99 = sorted[(count - 1) * 99 / 100] / 1000.0f;
+    stats->worst = sorted[count - 1] / 1000.0f;
+
+    for (total = 0, i = 0, n = (count + 99) / 100; i < n; ++i)
+        total += sorted[count - 1 - i];
+    stats->low1 = (total ? 1000000.0f * n / total : 0.0f);
+
+    for (total = 0, i = 0, n = (count + 999) / 1000; i < n; ++i)
+        total += sorted[count - 1 - i];
+    stats->low01 = (total ? 1000000.0f * n / total : 0.0f);
+}
+
+//
+// I_WriteFrameTimes
+// Writes the recorded frame times, oldest first, as CSV.
+//
+dboolean I_WriteFrameTimes(char *filename)
+{
+    FILE                *file = fopen(filename, "wt");
+    unsigned int        count = (frametimecount < FRAMETIMES ? frametimecount : FRAMETIMES);
+    unsigned int        i;
+
+    if (!file)
+        return false;
+
+    fputs("frame,milliseconds\n", file);
+
+    for (i = 0; i < count; ++i)
+        fprintf(file, "%u,%.3f\n", frametimecount - count + i + 1,
+            frametimes[(frametimecount - count + i) % FRAMETIMES] / 1000.0f);
+
+    fclose(file);
+    return true;
+}
+
 void I_Blit_AutoMap(void)
 {
     SDL_LowerBlit(mapsurface, &map_rect, mapbuffer, &map_rect);
@@ -1364,6 +1630,8 @@ static void SetVideoMode(dboolean output)
 
             if (vid_capfps)
                 C_Output("The framerate is capped at %i FPS.", TICRATE);
+            else if (vid_maxfps)
+                C_Output("The framerate is limited to %i FPS.", vid_maxfps);
             else if (rendererinfo.flags & SDL_RENDERER_PRESENTVSYNC)
             {
                 SDL_DisplayMode     displaymode;
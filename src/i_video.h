@@ -46,6 +46,21 @@
 
 #define GAMMALEVELS             31
 
+// number of frames kept for frame time statistics
+#define FRAMETIMES              4096
+
+typedef struct
+{
+    unsigned int        frames;
+    float               average;
+    float               p50;
+    float               p95;
+    float               p99;
+    float               worst;
+    float               low1;
+    float               low01;
+} frametimestats_t;
+
 typedef struct
 {
     int         width;
@@ -73,6 +88,15 @@ void I_ShutdownKeyboard(void);
 void I_SetPalette(byte *palette);
 
 void I_UpdateBlitFunc(dboolean shake);
+void I_UpdateFrameTimes(void);
+void I_ResetFrameTimes(void);
+void I_LatchMouse(void);
+int I_GetLatchedMouseX(void);
+void I_MouseShown(void);
+void I_StartFrameLimiter(void);
+void I_EndFrameLimiter(void);
+void I_GetFrameTimeStats(frametimestats_t *stats);
+dboolean I_WriteFrameTimes(char *filename);
 void I_Blit_AutoMap(void);
 void I_CreateExternalAutoMap(dboolean output);
 void I_DestroyExternalAutoMap(void);
@@ -117,6 +141,17 @@ void (*mapblitfunc)(void);
 
 extern int              vid_motionblur;
 extern dboolean         vid_showfps;
+
+extern uint32_t         frametimes[FRAMETIMES];
+extern unsigned int     frametimecount;
+extern unsigned int     framesmissed;
+extern int              vid_maxfps;
+
+extern dboolean         m_latelatch;
+extern dboolean         mouselatency;
+extern unsigned int     mouselatencycount;
+extern uint64_t         mouselatencytotal;
+extern uint64_t         mouselatencymax;
 extern dboolean         wipe;
 
 extern int              windowx;
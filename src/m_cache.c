@@ -0,0 +1,324 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include "m_cache.h"
+#include "m_misc.h"
+#include "version.h"
+#include "w_wad.h"
+
+// Data derived from the loaded WADs at startup is kept between launches in
+// one file in the app data folder. The file is keyed by a hash of the build,
+// the lump directory of every loaded WAD in order, and the size and time of
+// each WAD and DeHackEd file, so any change to them means a rebuild. Each
+// subsystem reads its own named section, and writes it if the read fails.
+// The whole file is written once setup has finished, and only if something
+// had to be rebuilt.
+#define STARTUPCACHEVERSION     PACKAGE_NAMEANDVERSIONSTRING" startup cache"
+#define MAXSTARTUPCACHESECTIONS 32
+
+typedef struct
+{
+    char                version[32];
+    uint64_t            key;
+    uint32_t            numsections;
+} startupcacheheader_t;
+
+typedef struct
+{
+    char                name[8];
+    uint32_t            size;
+} startupcachesection_t;
+
+typedef struct
+{
+    char                name[8];
+    uint32_t            size;
+    byte                *data;
+    dboolean            rebuilt;
+} startupcacheentry_t;
+
+static uint64_t                 startupcachekey = 14695981039346656037ull;
+static dboolean                 startupcacheopen;
+static dboolean                 startupcachedirty;
+
+static byte                     *startupcachedata;
+static startupcacheentry_t      startupcache[MAXSTARTUPCACHESECTIONS];
+static int                      numstartupcachesections;
+
+static void M_HashStartupCacheKey(const void *data, size_t size)
+{
+    const byte  *p = data;
+
+    while (size--)
+        startupcachekey = (startupcachekey ^ *p++) * 1099511628211ull;
+}
+
+static char *M_GetStartupCacheFile(void)
+{
+    return M_StringJoin(M_GetAppDataFolder(), DIR_SEPARATOR_S, PACKAGE_STARTUPCACHE, NULL);
+}
+
+//
+// M_AddStartupCacheFile
+//
+// Adds a file the startup data depends on to the cache's key.
+//
+void M_AddStartupCacheFile(char *filename)
+{
+    struct stat status;
+
+    M_HashStartupCacheKey(filename, strlen(filename));
+
+    if (!stat(filename, &status))
+    {
+        int64_t size = status.st_size;
+        int64_t time = status.st_mtime;
+
+        M_HashStartupCacheKey(&size, sizeof(size));
+        M_HashStartupCacheKey(&time, sizeof(time));
+    }
+}
+
+//
+// M_OpenStartupCache
+//
+// Called once every WAD has been loaded. Completes the key and, if the
+// cache file on disk has the same key, loads its sections.
+//
+void M_OpenStartupCache(void)
+{
+    wad_file_t          *wad = NULL;
+    char                *file;
+    FILE                *handle;
+    startupcacheheader_t header;
+    long                length;
+    int                 i;
+
+    M_HashStartupCacheKey(__DATE__ __TIME__, strlen(__DATE__ __TIME__));
+
+    for (i = 0; i < numlumps; ++i)
+    {
+        lumpinfo_t      *lump = lumpinfo[i];
+
+        if (lump->wad_file != wad)
+        {
+            wad = lump->wad_file;
+            M_AddStartupCacheFile(wad->path);
+            M_HashStartupCacheKey(&wad->length, sizeof(wad->length));
+        }
+
+        M_HashStartupCacheKey(lump->name, sizeof(lump->name));
+        M_HashStartupCacheKey(&lump->position, sizeof(lump->position));
+        M_HashStartupCacheKey(&lump->size, sizeof(lump->size));
+    }
+
+    startupcacheopen = true;
+
+    file = M_GetStartupCacheFile();
+    handle = fopen(file, "rb");
+    free(file);
+
+    if (!handle)
+        return;
+
+    fseek(handle, 0, SEEK_END);
+    length = ftell(handle);
+    fseek(handle, 0, SEEK_SET);
+
+    if (length > (long)sizeof(header) && fread(&header, sizeof(header), 1, handle) == 1
+        && !strncmp(header.version, STARTUPCACHEVERSION, sizeof(header.version))
+        && header.key == startupcachekey && header.numsections <= MAXSTARTUPCACHESECTIONS)
+    {
+        size_t  size = length - sizeof(header);
+        byte    *data = malloc(size);
+
+        if (fread(data, size, 1, handle) == 1)
+        {
+            byte        *p = data;
+            byte        *end = data + size;
+
+            for (i = 0; i < (int)header.numsections; ++i)
+            {
+                startupcachesection_t   section;
+
+                if (p + sizeof(section) > end)
+                    break;
+
+                memcpy(&section, p, sizeof(section));
+                p += sizeof(section);
+
+                if (section.size > (size_t)(end - p))
+                    break;
+
+                memcpy(startupcache[i].name, section.name, sizeof(section.name));
+                startupcache[i].size = section.size;
+                startupcache[i].data = p;
+                startupcache[i].rebuilt = false;
+                p += section.size;
+            }
+
+            numstartupcachesections = i;
+            startupcachedata = data;
+        }
+        else
+            free(data);
+    }
+
+    fclose(handle);
+}
+
+static startupcacheentry_t *M_FindStartupCacheSection(char *name)
+{
+    int i;
+
+    for (i = 0; i < numstartupcachesections; ++i)
+        if (!strncmp(startupcache[i].name, name, sizeof(startupcache[i].name)))
+            return &startupcache[i];
+
+    return NULL;
+}
+
+//
+// M_ReadStartupCache
+//
+// Copies a section into dest. Returns false if the section isn't in the
+// cache or is the wrong size, and it must be rebuilt.
+//
+dboolean M_ReadStartupCache(char *name, void *dest, size_t size)
+{
+    startupcacheentry_t *entry = M_FindStartupCacheSection(name);
+
+    if (!entry || entry->size != size)
+        return false;
+
+    memcpy(dest, entry->data, size);
+    return true;
+}
+
+//
+// M_WriteStartupCache
+//
+// Adds a rebuilt section, to be written by M_CloseStartupCache.
+//
+void M_WriteStartupCache(char *name, void *src, size_t size)
+{
+    startupcacheentry_t *entry;
+
+    if (!startupcacheopen)
+        return;
+
+    if (!(entry = M_FindStartupCacheSection(name)))
+    {
+        if (numstartupcachesections == MAXSTARTUPCACHESECTIONS)
+            return;
+
+        entry = &startupcache[numstartupcachesections++];
+        memset(entry->name, 0, sizeof(entry->name));
+        strncpy(entry->name, name, sizeof(entry->name));
+    }
+
+    if (entry->rebuilt)
+        free(entry->data);
+
+    entry->data = malloc(size);
+    entry->rebuilt = true;
+    memcpy(entry->data, src, size);
+    entry->size = (uint32_t)size;
+    startupcachedirty = true;
+}
+
+//
+// M_CloseStartupCache
+//
+// Called at the end of startup. Writes the cache file if any section was
+// rebuilt, then frees every section.
+//
+void M_CloseStartupCache(void)
+{
+    int i;
+
+    if (startupcachedirty)
+    {
+        char    *file = M_GetStartupCacheFile();
+        FILE    *handle = fopen(file, "wb");
+
+        if (handle)
+        {
+            startupcacheheader_t        header;
+            dboolean                    result;
+
+            memset(&header, 0, sizeof(header));
+            M_StringCopy(header.version, STARTUPCACHEVERSION, sizeof(header.version));
+            header.key = startupcachekey;
+            header.numsections = numstartupcachesections;
+            result = (fwrite(&header, sizeof(header), 1, handle) == 1);
+
+            for (i = 0; i < numstartupcachesections && result; ++i)
+            {
+                startupcachesection_t   section;
+
+                memcpy(section.name, startupcache[i].name, sizeof(section.name));
+                section.size = startupcache[i].size;
+                result = (fwrite(&section, sizeof(section), 1, handle) == 1
+                    && fwrite(startupcache[i].data, startupcache[i].size, 1, handle) == 1);
+            }
+
+            fclose(handle);
+
+            // Don't leave a partial cache behind for the next launch
+            if (!result)
+                remove(file);
+        }
+
+        free(file);
+    }
+
+    // Sections that were rebuilt were allocated separately, the rest point into
+    // the block read from disk
+    for (i = 0; i < numstartupcachesections; ++i)
+        if (startupcache[i].rebuilt)
+            free(startupcache[i].data);
+
+    free(startupcachedata);
+    startupcachedata = NULL;
+    numstartupcachesections = 0;
+    startupcacheopen = false;
+}
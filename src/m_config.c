@@ -68,8 +68,10 @@ extern int              am_thingcolor;
 extern int              am_tswallcolor;
 extern int              am_wallcolor;
 extern dboolean         autoload;
+extern int              cachesize;
 extern dboolean         centerweapon;
 extern dboolean         con_obituaries;
+extern int              con_scrollback;
 extern dboolean         con_timestamps;
 extern int              episode;
 extern int              expansion;
@@ -83,6 +85,7 @@ extern char             *iwadfolder;
 extern dboolean         messages;
 extern float            m_acceleration;
 extern dboolean         m_doubleclick_use;
+extern dboolean         m_latelatch;
 extern dboolean         m_novertical;
 extern int              m_sensitivity;
 extern int              m_threshold;
@@ -172,6 +175,7 @@ extern int              vid_display;
 extern char             *vid_driver;
 #endif
 extern dboolean         vid_fullscreen;
+extern int              vid_maxfps;
 extern int              vid_motionblur;
 extern char             *vid_scaleapi;
 extern char             *vid_scalefilter;
@@ -228,8 +232,10 @@ static default_t cvars[] =
     CONFIG_VARIABLE_INT          (am_tswallcolor,                                    NOALIAS    ),
     CONFIG_VARIABLE_INT          (am_wallcolor,                                      NOALIAS    ),
     CONFIG_VARIABLE_INT          (autoload,                                          BOOLALIAS  ),
+    CONFIG_VARIABLE_INT          (cachesize,                                         NOALIAS    ),
     CONFIG_VARIABLE_INT          (centerweapon,                                      BOOLALIAS  ),
     CONFIG_VARIABLE_INT          (con_obituaries,                                    BOOLALIAS  ),
+    CONFIG_VARIABLE_INT          (con_scrollback,                                    NOALIAS    ),
     CONFIG_VARIABLE_INT          (con_timestamps,                                    BOOLALIAS  ),
     CONFIG_VARIABLE_INT          (episode,                                           NOALIAS    ),
     CONFIG_VARIABLE_INT          (expansion,                                         NOALIAS    ),
@@ -242,6 +248,7 @@ static default_t cvars[] =
     CONFIG_VARIABLE_STRING       (iwadfolder,                                        NOALIAS    ),
     CONFIG_VARIABLE_FLOAT        (m_acceleration,                                    NOALIAS    ),
     CONFIG_VARIABLE_INT          (m_doubleclick_use,                                 BOOLALIAS  ),
+    CONFIG_VARIABLE_INT          (m_latelatch,                                       BOOLALIAS  ),
     CONFIG_VARIABLE_INT          (m_novertical,                                      BOOLALIAS  ),
     CONFIG_VARIABLE_INT          (m_sensitivity,                                     NOALIAS    ),
     CONFIG_VARIABLE_INT          (m_threshold,                                       NOALIAS    ),
@@ -297,6 +304,7 @@ static default_t cvars[] =
     CONFIG_VARIABLE_STRING       (vid_driver,                                        NOALIAS    ),
 #endif
     CONFIG_VARIABLE_INT          (vid_fullscreen,                                    BOOLALIAS  ),
+    CONFIG_VARIABLE_INT          (vid_maxfps,                                        NOALIAS    ),
     CONFIG_VARIABLE_INT_PERCENT  (vid_motionblur,                                    NOALIAS    ),
     CONFIG_VARIABLE_STRING       (vid_scaleapi,                                      NOALIAS    ),
     CONFIG_VARIABLE_STRING       (vid_scalefilter,                                   NOALIAS    ),
@@ -639,12 +647,16 @@ static void M_CheckCVARs(void)
     if (autoload != false && autoload != true)
         autoload = autoload_default;
 
+    cachesize = BETWEEN(cachesize_min, cachesize, cachesize_max);
+
     if (centerweapon != false && centerweapon != true)
         centerweapon = centerweapon_default;
 
     if (con_obituaries != false && con_obituaries != true)
         con_obituaries = con_obituaries_default;
 
+    con_scrollback = BETWEEN(con_scrollback_min, con_scrollback, con_scrollback_max);
+
     if (con_timestamps != false && con_timestamps != true)
         con_timestamps = con_timestamps_default;
 
@@ -673,6 +685,9 @@ static void M_CheckCVARs(void)
     if (m_doubleclick_use != false && m_doubleclick_use != true)
         m_doubleclick_use = m_doubleclick_use_default;
 
+    if (m_latelatch != false && m_latelatch != true)
+        m_latelatch = m_latelatch_default;
+
     if (m_novertical != false && m_novertical != true)
         m_novertical = m_novertical_default;
 
@@ -807,6 +822,8 @@ static void M_CheckCVARs(void)
     if (vid_fullscreen != false && vid_fullscreen != true)
         vid_fullscreen = vid_fullscreen_default;
 
+    vid_maxfps = BETWEEN(vid_maxfps_min, vid_maxfps, vid_maxfps_max);
+
     vid_motionblur = BETWEEN(vid_motionblur_min, vid_motionblur, vid_motionblur_max);
 
     if (!M_StringCompare(vid_scaleapi, vid_scaleapi_direct3d)
@@ -837,6 +854,43 @@ static void M_CheckCVARs(void)
     M_SaveCVARs();
 }
 
+//
+// M_GetCVARIndex
+// Returns the index in cvars[] of the CVAR with the given name, or -1 if there
+// isn't one. The names are hashed the first time this is called.
+//
+#define CVARHASHSIZE    512
+
+static int M_GetCVARIndex(char *name)
+{
+    static int      cvarhash[CVARHASHSIZE];     // index in cvars[] + 1, or 0 if empty
+    static dboolean hashed;
+    unsigned int    slot;
+
+    if (!hashed)
+    {
+        int i;
+
+        for (i = 0; i < arrlen(cvars); ++i)
+            if (*cvars[i].name && cvars[i].name[0] != ';')
+            {
+                slot = M_StringHash(cvars[i].name) & (CVARHASHSIZE - 1);
+                while (cvarhash[slot])
+                    slot = (slot + 1) & (CVARHASHSIZE - 1);
+                cvarhash[slot] = i + 1;
+            }
+
+        hashed = true;
+    }
+
+    for (slot = M_StringHash(name) & (CVARHASHSIZE - 1); cvarhash[slot];
+        slot = (slot + 1) & (CVARHASHSIZE - 1))
+        if (M_StringCompare(name, cvars[cvarhash[slot] - 1].name))
+            return cvarhash[slot] - 1;
+
+    return -1;
+}
+
 //
 // M_LoadCVARs
 //
@@ -886,13 +940,10 @@ void M_LoadCVARs(char *filename)
         M_StringCopy(strparm, uncommify(strparm), 256);
 
         // Find the setting in the list
-        for (i = 0; i < arrlen(cvars); ++i)
+        if ((i = M_GetCVARIndex(defname)) >= 0)
         {
             char        *s;
 
-            if (!M_StringCompare(defname, cvars[i].name))
-                continue;       // not this one
-
             // parameter found
             switch (cvars[i].type)
             {
@@ -932,9 +983,6 @@ void M_LoadCVARs(char *filename)
                     *(char **)cvars[i].location = strdup(strparm);
                     break;
             }
-
-            // finish
-            break;
         }
     }
 
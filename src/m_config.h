@@ -140,10 +140,18 @@ typedef enum
 
 #define autoload_default                        true
 
+#define cachesize_min                           0
+#define cachesize_default                       0
+#define cachesize_max                           4096
+
 #define centerweapon_default                    true
 
 #define con_obituaries_default                  false
 
+#define con_scrollback_min                      100
+#define con_scrollback_default                  4096
+#define con_scrollback_max                      65536
+
 #define con_timestamps_default                  true
 
 #define episode_min                             0
@@ -188,6 +196,8 @@ typedef enum
 
 #define m_doubleclick_use_default               false
 
+#define m_latelatch_default                     false
+
 #define m_novertical_default                    true
 
 #define m_sensitivity_min                       0
@@ -282,6 +292,8 @@ typedef enum
 #define r_shakescreen_default                   100
 #define r_shakescreen_max                       100
 
+#define r_showrenderstats_default               false
+
 #define r_translucency_default                  true
 
 #define s_musicvolume_min                       0
@@ -330,6 +342,10 @@ typedef enum
 
 #define vid_fullscreen_default                  true
 
+#define vid_maxfps_min                          0
+#define vid_maxfps_default                      0
+#define vid_maxfps_max                          1000
+
 #define vid_motionblur_min                      0
 #define vid_motionblur_default                  0
 #define vid_motionblur_max                      100
@@ -3400,7 +3400,7 @@ void M_Init(void)
     blurscreen2 = Z_Malloc(SCREENWIDTH * SCREENHEIGHT, PU_STATIC, NULL);
 
     pipechar = W_CacheLumpName((W_CheckNumForName("STCFN121") >= 0 ? "STCFN121" : "STCFN124"),
-        PU_CACHE);
+        PU_STATIC);
 
 #if defined(WIN32)
     caretblinktime = GetCaretBlinkTime();
@@ -467,6 +467,18 @@ dboolean M_StringCompare(const char *str1, const char *str2)
     return !strcasecmp(str1, str2);
 }
 
+// Returns a hash of 's' that is the same whatever its case, for use with
+// M_StringCompare().
+unsigned int M_StringHash(const char *s)
+{
+    unsigned int        result = 5381;
+
+    while (*s)
+        result = ((result << 5) + result) + tolower((unsigned char)*s++);
+
+    return result;
+}
+
 // Returns true if 's' begins with the specified prefix.
 dboolean M_StringStartsWith(char *s, char *prefix)
 {
@@ -78,6 +78,7 @@ int M_vsnprintf(char *buf, size_t buf_len, const char *s, va_list args);
 int M_snprintf(char *buf, size_t buf_len, const char *s, ...);
 char *M_SubString(const char *str, size_t begin, size_t len);
 dboolean M_StringCompare(const char *str1, const char *str2);
+unsigned int M_StringHash(const char *s);
 char *uppercase(const char *str);
 char *lowercase(const char *str);
 char *titlecase(const char *str);
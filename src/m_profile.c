@@ -0,0 +1,259 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include <string.h>
+
+#include "c_console.h"
+#include "i_timer.h"
+#include "m_misc.h"
+#include "m_profile.h"
+
+// Completed scopes are recorded into a ring buffer that is only ever
+// written by the main thread, so no locking is needed. The console's
+// summary is taken from whatever the ring currently holds, and the trace
+// file is appended to at the end of each frame.
+#define PROFILEEVENTS   65536
+#define MAXPROFILEDEPTH 16
+
+typedef struct
+{
+    uint64_t            start;
+    uint32_t            duration;
+    byte                scope;
+    byte                depth;
+} profevent_t;
+
+static char *profscopenames[NUMPROFSCOPES] =
+{
+    "Frame",
+    "TryRunTics",
+    "P_Ticker",
+    "P_RunThinkers",
+    "D_Display",
+    "R_RenderPlayerView",
+    "R_RenderBSPNode",
+    "R_DrawPlanes",
+    "R_DrawMasked",
+    "ST_Drawer",
+    "HU_Drawer",
+    "C_Drawer",
+    "blitfunc"
+};
+
+dboolean                profiling;
+
+static dboolean         profilerequested;
+
+static profevent_t      profevents[PROFILEEVENTS];
+static unsigned int     profhead;
+
+static uint64_t         profstack[MAXPROFILEDEPTH];
+static int              profdepth;
+
+static FILE             *proftrace;
+static unsigned int     proftraced;
+static dboolean         proftracestarted;
+
+void M_ProfileBegin(profscope_t scope)
+{
+    if (profdepth < MAXPROFILEDEPTH)
+        profstack[profdepth] = I_GetTimeUS();
+
+    ++profdepth;
+}
+
+void M_ProfileEnd(profscope_t scope)
+{
+    if (!profdepth)
+        return;
+
+    if (--profdepth < MAXPROFILEDEPTH)
+    {
+        profevent_t     *event = &profevents[profhead++ & (PROFILEEVENTS - 1)];
+
+        event->start = profstack[profdepth];
+        event->duration = (uint32_t)(I_GetTimeUS() - event->start);
+        event->scope = scope;
+        event->depth = profdepth;
+    }
+}
+
+//
+// Profiling is only switched on or off between frames so that every scope
+// that is begun is also ended.
+//
+void M_ProfileStartFrame(void)
+{
+    if (profiling != profilerequested)
+    {
+        profiling = profilerequested;
+        profdepth = 0;
+    }
+
+    PROFILE_BEGIN(PROF_FRAME);
+}
+
+static void M_FlushProfileTrace(void)
+{
+    // events that were overwritten before they could be written are lost
+    if (profhead - proftraced > PROFILEEVENTS)
+        proftraced = profhead - PROFILEEVENTS;
+
+    while (proftraced != profhead)
+    {
+        profevent_t     *event = &profevents[proftraced++ & (PROFILEEVENTS - 1)];
+
+        fprintf(proftrace, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%"PRIu64",\"dur\":%u,"
+            "\"pid\":1,\"tid\":1}", (proftracestarted ? ",\n" : ""),
+            profscopenames[event->scope], event->start, event->duration);
+        proftracestarted = true;
+    }
+}
+
+void M_ProfileEndFrame(void)
+{
+    if (!profiling)
+        return;
+
+    M_ProfileEnd(PROF_FRAME);
+
+    if (proftrace)
+        M_FlushProfileTrace();
+}
+
+void M_StartProfiling(void)
+{
+    profilerequested = true;
+}
+
+void M_StopProfiling(void)
+{
+    profilerequested = false;
+}
+
+dboolean M_ProfilingRequested(void)
+{
+    return profilerequested;
+}
+
+//
+// Write a summary of the frames currently in the ring buffer to the console
+//
+void M_ProfileSummary(void)
+{
+    uint64_t            total[NUMPROFSCOPES];
+    uint32_t            longest[NUMPROFSCOPES];
+    unsigned int        calls[NUMPROFSCOPES];
+    int                 depth[NUMPROFSCOPES];
+    unsigned int        count = (profhead < PROFILEEVENTS ? profhead : PROFILEEVENTS);
+    unsigned int        frames;
+    double              frametime;
+    unsigned int        i;
+    int                 tabs[8] = { 160, 230, 300, 370, 0, 0, 0, 0 };
+
+    memset(total, 0, sizeof(total));
+    memset(longest, 0, sizeof(longest));
+    memset(calls, 0, sizeof(calls));
+    memset(depth, 0, sizeof(depth));
+
+    for (i = profhead - count; i != profhead; ++i)
+    {
+        profevent_t     *event = &profevents[i & (PROFILEEVENTS - 1)];
+
+        total[event->scope] += event->duration;
+        if (event->duration > longest[event->scope])
+            longest[event->scope] = event->duration;
+        ++calls[event->scope];
+        depth[event->scope] = event->depth;
+    }
+
+    if (!(frames = calls[PROF_FRAME]))
+    {
+        C_Output("No frames have been profiled yet.");
+        return;
+    }
+
+    frametime = (double)total[PROF_FRAME] / frames / 1000.0;
+
+    C_Output("Profile of the last <b>%s</b> frames (<b>%.2f</b> ms per frame):", commify(frames),
+        frametime);
+    C_TabbedOutput(tabs, "<b>Scope</b>\t<b>Calls</b>\t<b>Avg ms</b>\t<b>Max ms</b>\t<b>Frame</b>");
+
+    for (i = 0; i < NUMPROFSCOPES; ++i)
+    {
+        char    name[64];
+        double  average;
+
+        if (!calls[i])
+            continue;
+
+        M_snprintf(name, sizeof(name), "%*s%s", depth[i] * 2, "", profscopenames[i]);
+        average = (double)total[i] / frames / 1000.0;
+        C_TabbedOutput(tabs, "%s\t%.1f\t%.3f\t%.3f\t%.1f%%", name, (double)calls[i] / frames,
+            average, longest[i] / 1000.0, average * 100.0 / frametime);
+    }
+}
+
+//
+// Open a trace file in the JSON array format read by chrome://tracing and
+// Perfetto. The closing bracket is optional in that format, so the trace
+// can still be read if DOOM Retro doesn't exit cleanly.
+//
+dboolean M_OpenProfileTrace(char *filename)
+{
+    if (!(proftrace = fopen(filename, "wt")))
+        return false;
+
+    fputs("[\n", proftrace);
+    proftraced = profhead;
+    proftracestarted = false;
+    M_StartProfiling();
+
+    return true;
+}
+
+void M_CloseProfileTrace(void)
+{
+    if (!proftrace)
+        return;
+
+    M_FlushProfileTrace();
+    fputs("\n]\n", proftrace);
+    fclose(proftrace);
+    proftrace = NULL;
+}
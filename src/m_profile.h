@@ -0,0 +1,82 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#if !defined(__M_PROFILE_H__)
+#define __M_PROFILE_H__
+
+#include "doomtype.h"
+
+typedef enum
+{
+    PROF_FRAME,
+    PROF_TRYRUNTICS,
+    PROF_P_TICKER,
+    PROF_P_RUNTHINKERS,
+    PROF_D_DISPLAY,
+    PROF_R_RENDERPLAYERVIEW,
+    PROF_R_RENDERBSPNODE,
+    PROF_R_DRAWPLANES,
+    PROF_R_DRAWMASKED,
+    PROF_ST_DRAWER,
+    PROF_HU_DRAWER,
+    PROF_C_DRAWER,
+    PROF_BLITFUNC,
+    NUMPROFSCOPES
+} profscope_t;
+
+extern dboolean profiling;
+
+void M_ProfileBegin(profscope_t scope);
+void M_ProfileEnd(profscope_t scope);
+
+// Scopes cost a single test of profiling when the profiler is off.
+#define PROFILE_BEGIN(scope)    do { if (profiling) M_ProfileBegin(scope); } while (0)
+#define PROFILE_END(scope)      do { if (profiling) M_ProfileEnd(scope); } while (0)
+
+void M_ProfileStartFrame(void);
+void M_ProfileEndFrame(void);
+
+void M_StartProfiling(void);
+void M_StopProfiling(void);
+dboolean M_ProfilingRequested(void);
+void M_ProfileSummary(void);
+
+dboolean M_OpenProfileTrace(char *filename);
+void M_CloseProfileTrace(void);
+
+#endif
@@ -36,18 +36,20 @@
 ========================================================================
 */
 
-#include <stdlib.h>
 #include <time.h>
 
-int M_Random(void)
-{
-    return (rand() & 255);
-}
+#include "m_random.h"
 
-int M_RandomInt(int lower, int upper)
-{
-    return (rand() % (upper - lower + 1) + lower);
-}
+// Marsaglia's xorshift32 generator, with two independent streams. rndseed
+// drives gameplay and is saved in savegames, so a level played from the
+// same seed with the same input always plays out the same. fxrndseed is
+// used for purely cosmetic effects, so that the number of frames rendered
+// never disturbs the gameplay stream.
+unsigned int    rndseed = 1;
+unsigned int    fxrndseed = 1;
+
+// Seed given with -seed, or 0 to seed from the time at each level start.
+unsigned int    startseed;
 
 int M_RandomIntNoRepeat(int lower, int upper, int previous)
 {
@@ -59,7 +61,14 @@ int M_RandomIntNoRepeat(int lower, int upper, int previous)
     return randomint;
 }
 
+void M_Seed(unsigned int value)
+{
+    // xorshift never leaves a state of 0
+    rndseed = (value ? value : 1);
+    fxrndseed = (rndseed ^ 0x9E3779B9 ? rndseed ^ 0x9E3779B9 : 1);
+}
+
 void M_ClearRandom(void)
 {
-    srand((unsigned int)time(NULL));
+    M_Seed(startseed ? startseed : (unsigned int)time(NULL));
 }
@@ -39,13 +39,43 @@
 #if !defined(__M_RANDOM_H__)
 #define __M_RANDOM_H__
 
-// Returns a number from 0 to 255,
-// from a lookup table.
-int M_Random(void);
+extern unsigned int     rndseed;
+extern unsigned int     fxrndseed;
+extern unsigned int     startseed;
+
+static __inline unsigned int M_XorShift(unsigned int *state)
+{
+    unsigned int        x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return (*state = x);
+}
+
+// Returns a number from 0 to 255 from the gameplay stream.
+static __inline int M_Random(void)
+{
+    return (M_XorShift(&rndseed) >> 24);
+}
+
+// Returns a number from lower to upper inclusive from the gameplay stream.
+static __inline int M_RandomInt(int lower, int upper)
+{
+    return ((int)(M_XorShift(&rndseed) % (unsigned int)(upper - lower + 1)) + lower);
+}
+
+// Returns a non-negative number from the cosmetic stream. Use this in place
+// of rand() for effects that don't affect gameplay.
+static __inline int M_FXRandom(void)
+{
+    return (int)(M_XorShift(&fxrndseed) >> 1);
+}
 
-void M_ClearRandom(void);
 int M_RandomIntNoRepeat(int lower, int upper, int previous);
 
-int M_RandomInt(int, int);
+void M_Seed(unsigned int value);
+void M_ClearRandom(void);
 
 #endif
@@ -235,7 +235,7 @@ dboolean EV_DoCeiling(line_t *line, ceiling_e type)
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_PoolCalloc(&ceilingpool);
         P_AddThinker(&ceiling->thinker);
         sec->ceilingdata = ceiling;
         ceiling->thinker.function = T_MoveCeiling;
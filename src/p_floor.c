@@ -350,7 +350,7 @@ dboolean EV_DoFloor(line_t *line, floor_e floortype)
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_PoolCalloc(&floorpool);
         P_AddThinker(&floor->thinker);
         sec->floordata = floor;
         floor->thinker.function = T_MoveFloor;
@@ -642,7 +642,7 @@ dboolean EV_BuildStairs(line_t *line, stair_e type)
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_PoolCalloc(&floorpool);
         P_AddThinker(&floor->thinker);
         sec->floordata = floor;
         floor->thinker.function = T_MoveFloor;
@@ -711,7 +711,7 @@ dboolean EV_BuildStairs(line_t *line, stair_e type)
 
                 sec = tsec;
                 secnum = newsecnum;
-                floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+                floor = Z_PoolCalloc(&floorpool);
                 P_AddThinker(&floor->thinker);
 
                 sec->floordata = floor;
@@ -758,7 +758,7 @@ dboolean EV_DoElevator(line_t *line, elevator_e elevtype)
 
         // create and initialize new elevator thinker
         rtn = true;
-        elevator = Z_Calloc(1, sizeof(*elevator), PU_LEVSPEC, NULL);
+        elevator = Z_PoolCalloc(&elevatorpool);
         P_AddThinker(&elevator->thinker);
         sec->floordata = elevator;
         sec->ceilingdata = elevator;
@@ -98,7 +98,7 @@ manual_floor:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_PoolCalloc(&floorpool);
         P_AddThinker(&floor->thinker);
         sec->floordata = floor;
         floor->thinker.function = T_MoveFloor;
@@ -302,7 +302,7 @@ manual_ceiling:
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_PoolCalloc(&ceilingpool);
         P_AddThinker(&ceiling->thinker);
         sec->ceilingdata = ceiling;
         ceiling->thinker.function = T_MoveCeiling;
@@ -509,7 +509,7 @@ manual_lift:
 
         // Setup the plat thinker
         rtn = true;
-        plat = Z_Calloc(1, sizeof(*plat), PU_LEVSPEC, NULL);
+        plat = Z_PoolCalloc(&platpool);
         P_AddThinker(&plat->thinker);
         plat->sector = sec;
         plat->sector->floordata = plat;
@@ -672,7 +672,7 @@ manual_stair:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_PoolCalloc(&floorpool);
         P_AddThinker(&floor->thinker);
         sec->floordata = floor;
         floor->thinker.function = T_MoveFloor;
@@ -775,7 +775,7 @@ manual_stair:
 
                 sec = tsec;
                 secnum = newsecnum;
-                floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+                floor = Z_PoolCalloc(&floorpool);
 
                 P_AddThinker(&floor->thinker);
 
@@ -855,7 +855,7 @@ manual_crusher:
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_PoolCalloc(&ceilingpool);
         P_AddThinker(&ceiling->thinker);
         sec->ceilingdata = ceiling;     // jff 2/22/98
         ceiling->thinker.function = T_MoveCeiling;
@@ -949,7 +949,7 @@ manual_locked:
 
         // new door thinker
         rtn = true;
-        door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+        door = Z_PoolCalloc(&doorpool);
         P_AddThinker(&door->thinker);
         sec->ceilingdata = door;        // jff 2/22/98
 
@@ -1051,7 +1051,7 @@ manual_door:
 
         // new door thinker
         rtn = true;
-        door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+        door = Z_PoolCalloc(&doorpool);
         P_AddThinker(&door->thinker);
         sec->ceilingdata = door;
 
@@ -1266,7 +1266,7 @@ void P_KillMobj(mobj_t *source, mobj_t *target)
     mo->momz = FRACUNIT * 5 + (M_Random() << 10);
     mo->angle = target->angle + ((M_Random() - M_Random()) << 20);
     mo->flags |= MF_DROPPED;    // special versions of items
-    if (r_mirroredweapons && (rand() & 1))
+    if (r_mirroredweapons && (M_FXRandom() & 1))
     {
         mo->flags2 |= MF2_MIRRORED;
         if (mo->shadow)
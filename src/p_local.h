@@ -116,7 +116,6 @@ void P_ResurrectPlayer(player_t *player, int health);
 #define CARDNOTINMAP            0
 
 extern int                      r_blood;
-extern mobj_t                   *bloodsplats[r_bloodsplats_max_max];
 extern int                      r_bloodsplats_total;
 extern int                      r_bloodsplats_max;
 
@@ -145,6 +144,10 @@ void P_MobjThinker(mobj_t *mobj);
 void P_SpawnPuff(fixed_t x, fixed_t y, fixed_t z, angle_t angle);
 void P_SpawnSmokeTrail(fixed_t x, fixed_t y, fixed_t z, angle_t angle);
 void P_SpawnBlood(fixed_t x, fixed_t y, fixed_t z, angle_t angle, int damage, mobj_t *target);
+void P_InitBloodSplats(void);
+void P_ClearBloodSplats(void);
+void P_RemoveBloodSplats(sector_t *sec);
+void P_AddBloodSplat(fixed_t x, fixed_t y, sector_t *sec, int blood, int frame, int flags);
 void P_SpawnBloodSplat(fixed_t x, fixed_t y, int blood, int maxheight, mobj_t *target);
 void P_NullBloodSplatSpawner(fixed_t x, fixed_t y, int blood, int maxheight, mobj_t *target);
 mobj_t *P_SpawnMissile(mobj_t *source, mobj_t *dest, mobjtype_t type);
@@ -205,7 +208,6 @@ dboolean P_PathTraverse(fixed_t x1, fixed_t y1, fixed_t x2, fixed_t y2, int flag
 
 void P_UnsetThingPosition(mobj_t *thing);
 void P_SetThingPosition(mobj_t *thing);
-void P_SetBloodSplatPosition(mobj_t *splat);
 
 //
 // P_MAP
@@ -224,6 +226,12 @@ extern line_t           *blockline;
 
 extern dboolean         infight;
 
+// time spent in P_TryMove and P_CheckSight when playsimtiming is set
+extern uint64_t         trymovetime;
+extern unsigned int     trymovecalls;
+extern uint64_t         checksighttime;
+extern unsigned int     checksightcalls;
+
 dboolean P_CheckPosition(mobj_t *thing, fixed_t x, fixed_t y);
 mobj_t *P_CheckOnmobj(mobj_t *thing);
 void P_FakeZMovement(mobj_t *mo);
@@ -37,9 +37,11 @@
 */
 
 #include "doomstat.h"
+#include "i_timer.h"
 #include "m_bbox.h"
 #include "m_random.h"
 #include "p_local.h"
+#include "p_tick.h"
 #include "s_sound.h"
 #include "z_zone.h"
 
@@ -90,6 +92,9 @@ mobj_t          *onmobj;
 
 unsigned int    stat_distancetravelled = 0;
 
+uint64_t        trymovetime;
+unsigned int    trymovecalls;
+
 extern dboolean successfulshot;
 extern dboolean stat_shotshit;
 
@@ -894,7 +899,7 @@ void P_FakeZMovement(mobj_t *mo)
 // Attempt to move to a new position,
 // crossing special lines unless MF_TELEPORT is set.
 //
-dboolean P_TryMove(mobj_t *thing, fixed_t x, fixed_t y, dboolean dropoff)
+static dboolean P_DoTryMove(mobj_t *thing, fixed_t x, fixed_t y, dboolean dropoff)
 {
     fixed_t     oldx;
     fixed_t     oldy;
@@ -1007,6 +1012,21 @@ dboolean P_TryMove(mobj_t *thing, fixed_t x, fixed_t y, dboolean dropoff)
     return true;
 }
 
+dboolean P_TryMove(mobj_t *thing, fixed_t x, fixed_t y, dboolean dropoff)
+{
+    if (playsimtiming)
+    {
+        uint64_t        start = I_GetTimeUS();
+        dboolean        result = P_DoTryMove(thing, x, y, dropoff);
+
+        trymovetime += I_GetTimeUS() - start;
+        ++trymovecalls;
+        return result;
+    }
+
+    return P_DoTryMove(thing, x, y, dropoff);
+}
+
 //
 // killough 9/12/98:
 //
@@ -2009,6 +2029,8 @@ dboolean P_ChangeSector(sector_t *sector, dboolean crunch)
 
     if (isliquidsector)
     {
+        P_RemoveBloodSplats(sector);
+
         do
             for (n = sector->touching_thinglist; n; n = n->m_snext)     // go through list
                 if (!n->visited)                                        // unprocessed thing found
@@ -2018,12 +2040,7 @@ dboolean P_ChangeSector(sector_t *sector, dboolean crunch)
                     if (mobj)
                     {
                         type = mobj->type;
-                        if (type == MT_BLOODSPLAT)
-                        {
-                            P_UnsetThingPosition(mobj);
-                            --r_bloodsplats_total;
-                        }
-                        else if (type != MT_SHADOW && !(mobj->flags & MF_NOBLOCKMAP))
+                        if (type != MT_SHADOW && !(mobj->flags & MF_NOBLOCKMAP))
                             PIT_ChangeSector(mobj);                     // process it
                     }
                     break;                                              // exit and start over
@@ -2044,8 +2061,7 @@ dboolean P_ChangeSector(sector_t *sector, dboolean crunch)
                     if (mobj)
                     {
                         type = mobj->type;
-                        if (type != MT_BLOODSPLAT && type != MT_SHADOW
-                            && !(mobj->flags & MF_NOBLOCKMAP))
+                        if (type != MT_SHADOW && !(mobj->flags & MF_NOBLOCKMAP))
                             PIT_ChangeSector(mobj);                     // process it
                     }
                     break;                                              // exit and start over
@@ -314,24 +314,6 @@ void P_SetThingPosition(mobj_t *thing)
     }
 }
 
-//
-// P_SetBloodSplatPosition
-//
-void P_SetBloodSplatPosition(mobj_t *splat)
-{
-    mobj_t      **link = &splat->subsector->sector->thinglist;
-    mobj_t      *snext = *link;
-
-    if ((splat->snext = snext))
-        snext->sprev = &splat->snext;
-    splat->sprev = link;
-    *link = splat;
-
-    P_CreateSecNodeList(splat, splat->x, splat->y);
-    splat->touching_sectorlist = sector_list;
-    sector_list = NULL;
-}
-
 //
 // BLOCK MAP ITERATORS
 // For each line/thing in the given mapblock,
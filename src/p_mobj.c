@@ -54,8 +54,11 @@ void P_SpawnShadow(mobj_t *actor);
 
 int                     r_blood = r_blood_default;
 int                     r_bloodsplats_max = r_bloodsplats_max_default;
-mobj_t                  *bloodsplats[r_bloodsplats_max_max];
 int                     r_bloodsplats_total;
+
+static bloodsplat_t     *bloodsplats;
+static int              numbloodsplats;
+static int              bloodsplatcursor;
 void                    (*P_BloodSplatSpawner)(fixed_t, fixed_t, int, int, mobj_t *);
 
 dboolean                r_corpses_color = r_corpses_color_default;
@@ -684,7 +687,7 @@ void P_MobjThinker(mobj_t *mobj)
 //
 mobj_t *P_SpawnMobj(fixed_t x, fixed_t y, fixed_t z, mobjtype_t type)
 {
-    mobj_t      *mobj = Z_Calloc(1, sizeof(*mobj), PU_LEVEL, NULL);
+    mobj_t      *mobj = Z_PoolCalloc(&mobjpool);
     state_t     *st;
     mobjinfo_t  *info = &mobjinfo[type];
     sector_t    *sector;
@@ -1130,7 +1133,7 @@ void P_SpawnMapThing(mapthing_t *mthing, int index)
 
     // [BH] randomly mirror weapons
     if (r_mirroredweapons && (type == SuperShotgun || (type >= Shotgun && type <= BFG9000))
-        && (rand() & 1))
+        && (M_FXRandom() & 1))
         mobj->flags2 |= MF2_MIRRORED;
 
     // [BH] Spawn blood splats around corpses
@@ -1165,7 +1168,7 @@ void P_SpawnPuff(fixed_t x, fixed_t y, fixed_t z, angle_t angle)
 
     th->angle = angle;
 
-    th->flags2 |= (rand() & 1) * MF2_MIRRORED;
+    th->flags2 |= (M_FXRandom() & 1) * MF2_MIRRORED;
 
     // don't make punches spark on the wall
     if (attackrange == MELEERANGE)
@@ -1197,7 +1200,7 @@ void P_SpawnSmokeTrail(fixed_t x, fixed_t y, fixed_t z, angle_t angle)
 
     th->angle = angle;
 
-    th->flags2 |= (rand() & 1) * MF2_MIRRORED;
+    th->flags2 |= (M_FXRandom() & 1) * MF2_MIRRORED;
 }
 
 //
@@ -1216,7 +1219,7 @@ void P_SpawnBlood(fixed_t x, fixed_t y, fixed_t z, angle_t angle, int damage, mo
 
     for (i = (damage >> 2) + 1; i; i--)
     {
-        mobj_t      *th = Z_Calloc(1, sizeof(*th), PU_LEVEL, NULL);
+        mobj_t      *th = Z_PoolCalloc(&mobjpool);
         state_t     *st;
 
         th->type = color;
@@ -1224,7 +1227,7 @@ void P_SpawnBlood(fixed_t x, fixed_t y, fixed_t z, angle_t angle, int damage, mo
         th->x = x;
         th->y = y;
         th->flags = info->flags;
-        th->flags2 = (info->flags2 | (rand() & 1) * MF2_MIRRORED);
+        th->flags2 = (info->flags2 | (M_FXRandom() & 1) * MF2_MIRRORED);
 
         st = &states[info->spawnstate];
 
@@ -1262,49 +1265,134 @@ void P_SpawnBlood(fixed_t x, fixed_t y, fixed_t z, angle_t angle, int damage, mo
 }
 
 //
-// P_SpawnBloodSplat
+// P_InitBloodSplats
+// Size the blood splat pool to r_bloodsplats_max and empty it. Sectors must
+// not be left pointing into the pool (see P_ClearBloodSplats).
 //
-void P_SpawnBloodSplat(fixed_t x, fixed_t y, int blood, int maxheight, mobj_t *target)
+void P_InitBloodSplats(void)
 {
-    subsector_t *subsec = R_PointInSubsector(x, y);
-    sector_t    *sec = subsec->sector;
-    short       floorpic = sec->floorpic;
-
-    if (!isliquid[floorpic] && sec->floorheight <= maxheight && floorpic != skyflatnum)
+    if (numbloodsplats != r_bloodsplats_max)
     {
-        mobj_t  *newsplat = Z_Calloc(1, sizeof(*newsplat), PU_LEVEL, NULL);
+        if (bloodsplats)
+            Z_Free(bloodsplats);
 
-        newsplat->type = MT_BLOODSPLAT;
-        newsplat->sprite = SPR_BLD2;
-        newsplat->frame = rand() & 7;
+        bloodsplats = NULL;
+        numbloodsplats = r_bloodsplats_max;
 
-        newsplat->flags2 = (MF2_DONOTMAP | ((rand() & 1) * MF2_MIRRORED));
-        if (blood == FUZZYBLOOD)
+        if (numbloodsplats)
         {
-            newsplat->flags = MF_FUZZ;
-            newsplat->colfunc = fuzzcolfunc;
+            bloodsplats = Z_Malloc(numbloodsplats * sizeof(*bloodsplats), PU_STATIC, NULL);
+            Z_ChangeOwner(bloodsplats, ZO_BLOODSPLAT);
         }
-        else
-            newsplat->colfunc = bloodsplatcolfunc;
-        newsplat->projectfunc = R_ProjectBloodSplat;
-        newsplat->blood = blood;
+    }
 
-        newsplat->x = x;
-        newsplat->y = y;
-        newsplat->subsector = subsec;
-        P_SetBloodSplatPosition(newsplat);
+    if (bloodsplats)
+        memset(bloodsplats, 0, numbloodsplats * sizeof(*bloodsplats));
 
-        if (r_bloodsplats_total >= r_bloodsplats_max)
-        {
-            mobj_t      *oldsplat = bloodsplats[r_bloodsplats_total % r_bloodsplats_max];
+    bloodsplatcursor = 0;
+    r_bloodsplats_total = 0;
+}
 
-            if (oldsplat)
-                P_UnsetThingPosition(oldsplat);
+//
+// P_ClearBloodSplats
+// Remove every blood splat in the current level, resizing the pool if
+// r_bloodsplats_max has changed.
+//
+void P_ClearBloodSplats(void)
+{
+    int i;
 
-            bloodsplats[r_bloodsplats_total % r_bloodsplats_max] = newsplat;
-        }
-        else
-            bloodsplats[r_bloodsplats_total++ % r_bloodsplats_max] = newsplat;
+    for (i = 0; i < numsectors; ++i)
+        sectors[i].splatlist = NULL;
+
+    P_InitBloodSplats();
+}
+
+static void P_UnlinkBloodSplat(bloodsplat_t *splat)
+{
+    bloodsplat_t    *snext = splat->snext;
+
+    if ((*splat->sprev = snext))
+        snext->sprev = splat->sprev;
+
+    splat->sector = NULL;
+}
+
+//
+// P_RemoveBloodSplats
+// Remove the blood splats in a sector, such as when its floor becomes liquid.
+//
+void P_RemoveBloodSplats(sector_t *sec)
+{
+    bloodsplat_t    *splat = sec->splatlist;
+
+    while (splat)
+    {
+        bloodsplat_t    *snext = splat->snext;
+
+        splat->sector = NULL;
+        --r_bloodsplats_total;
+        splat = snext;
+    }
+
+    sec->splatlist = NULL;
+}
+
+//
+// P_AddBloodSplat
+// Take the oldest record in the pool, unlinking it from its sector if it is
+// still in use, and link it into the new sector.
+//
+void P_AddBloodSplat(fixed_t x, fixed_t y, sector_t *sec, int blood, int frame, int flags)
+{
+    bloodsplat_t    *splat;
+    bloodsplat_t    **link;
+
+    if (!numbloodsplats)
+        return;
+
+    splat = &bloodsplats[bloodsplatcursor];
+
+    if (++bloodsplatcursor == numbloodsplats)
+        bloodsplatcursor = 0;
+
+    if (splat->sector)
+        P_UnlinkBloodSplat(splat);
+    else
+        ++r_bloodsplats_total;
+
+    splat->x = x;
+    splat->y = y;
+    splat->sector = sec;
+    splat->blood = blood;
+    splat->frame = frame;
+    splat->flags = flags;
+
+    link = &sec->splatlist;
+
+    if ((splat->snext = *link))
+        splat->snext->sprev = &splat->snext;
+    splat->sprev = link;
+    *link = splat;
+}
+
+//
+// P_SpawnBloodSplat
+//
+void P_SpawnBloodSplat(fixed_t x, fixed_t y, int blood, int maxheight, mobj_t *target)
+{
+    sector_t    *sec = R_PointInSubsector(x, y)->sector;
+    short       floorpic = sec->floorpic;
+
+    if (!isliquid[floorpic] && sec->floorheight <= maxheight && floorpic != skyflatnum)
+    {
+        int     frame = M_FXRandom() & 7;
+        int     flags = ((M_FXRandom() & 1) * BSF_MIRRORED);
+
+        if (blood == FUZZYBLOOD)
+            flags |= BSF_FUZZ;
+
+        P_AddBloodSplat(x, y, sec, blood, frame, flags);
 
         if (target)
             target->bloodsplats = MAX(0, target->bloodsplats - 1);
@@ -1318,7 +1406,7 @@ void P_NullBloodSplatSpawner(fixed_t x, fixed_t y, int blood, int maxheight, mob
 //
 void P_SpawnShadow(mobj_t *actor)
 {
-    mobj_t      *mobj = Z_Calloc(1, sizeof(*mobj), PU_LEVEL, NULL);
+    mobj_t      *mobj = Z_PoolCalloc(&mobjpool);
 
     mobj->type = MT_SHADOW;
     mobj->info = &mobjinfo[MT_SHADOW];
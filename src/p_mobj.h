@@ -299,6 +299,13 @@ typedef enum
 // Map Object definition.
 typedef struct mobj_s
 {
+    //
+    // Hot fields. These are what blockmap and sector iteration, collision
+    // checks and sprite projection touch for every mobj they visit, and are
+    // ordered to fill the first cache lines of the struct. Keep thinker, x, y
+    // and z first to match degenmobj_t.
+    //
+
     // List: thinker links.
     thinker_t           thinker;
 
@@ -307,22 +314,31 @@ typedef struct mobj_s
     fixed_t             y;
     fixed_t             z;
 
-    // More list: links in sector (if needed)
-    struct mobj_s       *snext;
-    struct mobj_s       **sprev;        // killough 8/10/98: change to ptr-to-ptr
-
-    //More drawing info: to determine current sprite.
-    angle_t             angle;          // orientation
-    spritenum_t         sprite;         // used to find patch_t and flip value
-    int                 frame;          // might be ORed with FF_FULLBRIGHT
-
     // Interaction info, by BLOCKMAP.
     // Links in blocks (if needed).
     struct mobj_s       *bnext;
     struct mobj_s       **bprev;        // killough 8/11/98: change to ptr-to-ptr
 
+    // For movement checking.
+    fixed_t             radius;
+    fixed_t             height;
+
+    int                 flags;
+    int                 flags2;
+    mobjtype_t          type;
+
+    //More drawing info: to determine current sprite.
+    angle_t             angle;          // orientation
+
+    // More list: links in sector (if needed)
+    struct mobj_s       *snext;
+    struct mobj_s       **sprev;        // killough 8/10/98: change to ptr-to-ptr
+
     struct subsector_s  *subsector;
 
+    spritenum_t         sprite;         // used to find patch_t and flip value
+    int                 frame;          // might be ORed with FF_FULLBRIGHT
+
     // The closest interval over all contacted Sectors.
     fixed_t             floorz;
     fixed_t             ceilingz;
@@ -330,9 +346,37 @@ typedef struct mobj_s
     // killough 11/98: the lowest floor over all contacted Sectors.
     fixed_t             dropoffz;
 
-    // For movement checking.
-    fixed_t             radius;
-    fixed_t             height;
+    int                 health;
+
+    // [AM] If true, ok to interpolate this tic.
+    dboolean            interp;
+
+    // [AM] Previous position of mobj before think.
+    //      Used to interpolate between positions.
+    fixed_t             oldx;
+    fixed_t             oldy;
+    fixed_t             oldz;
+    angle_t             oldangle;
+
+    void                (*colfunc)(void);
+    void                (*projectfunc)();
+
+    mobjinfo_t          *info;          // &mobjinfo[mobj->type]
+    state_t             *state;
+
+    // Thing being chased/attacked (or NULL),
+    // also the originator for missiles.
+    struct mobj_s       *target;
+
+    // Additional info record for player avatars only.
+    // Only valid if type == MT_PLAYER
+    struct player_s     *player;
+
+    struct mobj_s       *shadow;
+
+    //
+    // Cold fields, mostly only touched by the mobj's own thinker.
+    //
 
     fixed_t             projectilepassheight;
 
@@ -341,23 +385,12 @@ typedef struct mobj_s
     fixed_t             momy;
     fixed_t             momz;
 
-    mobjtype_t          type;
-    mobjinfo_t          *info;          // &mobjinfo[mobj->type]
-
     int                 tics;           // state tic counter
-    state_t             *state;
-    int                 flags;
-    int                 flags2;
-    int                 health;
 
     // Movement direction, movement generation (zig-zagging).
     int                 movedir;        // 0-7
     int                 movecount;      // when 0, select a new dir
 
-    // Thing being chased/attacked (or NULL),
-    // also the originator for missiles.
-    struct mobj_s       *target;
-
     // Reaction time: if non 0, don't attack yet.
     // Used by player to freeze a bit after teleporting.
     int                 reactiontime;
@@ -366,10 +399,6 @@ typedef struct mobj_s
     // no matter what (even if shot)
     int                 threshold;
 
-    // Additional info record for player avatars only.
-    // Only valid if type == MT_PLAYER
-    struct player_s     *player;
-
     // Player number last looked for.
     int                 lastlook;
 
@@ -385,29 +414,14 @@ typedef struct mobj_s
     // For bobbing up and down.
     int                 floatbob;
 
-    void                (*colfunc)(void);
-    void                (*projectfunc)();
-
-    // a linked list of sectors where this object appears
-    struct msecnode_s   *touching_sectorlist;   // phares 3/14/98
-
     short               gear;           // killough 11/98: used in torque simulation
 
     int                 bloodsplats;
 
-    struct mobj_s       *shadow;
-
     int                 blood;
 
-    // [AM] If true, ok to interpolate this tic.
-    dboolean            interp;
-
-    // [AM] Previous position of mobj before think.
-    //      Used to interpolate between positions.
-    fixed_t             oldx;
-    fixed_t             oldy;
-    fixed_t             oldz;
-    angle_t             oldangle;
+    // a linked list of sectors where this object appears
+    struct msecnode_s   *touching_sectorlist;   // phares 3/14/98
 
     fixed_t             nudge;
 
@@ -416,4 +430,26 @@ typedef struct mobj_s
     int                 id;
 } mobj_t;
 
+#define BSF_FUZZ                1
+#define BSF_MIRRORED            2
+
+//
+// Blood splats are decals on the floor that never think, so rather than being
+// full mobjs they are kept in a fixed pool of r_bloodsplats_max records that
+// is recycled oldest first, and are linked into the splatlist of their sector.
+//
+typedef struct bloodsplat_s
+{
+    fixed_t                 x;
+    fixed_t                 y;
+    struct sector_s         *sector;
+
+    struct bloodsplat_s     *snext;
+    struct bloodsplat_s     **sprev;
+
+    int                     blood;
+    byte                    frame;
+    byte                    flags;
+} bloodsplat_t;
+
 #endif
@@ -41,6 +41,7 @@
 #include "doomstat.h"
 #include "i_system.h"
 #include "m_misc.h"
+#include "m_random.h"
 #include "p_local.h"
 #include "p_saveg.h"
 #include "p_tick.h"
@@ -1649,6 +1650,8 @@ void P_WriteSaveGameHeader(char *description)
     saveg_write8((leveltime >> 16) & 0xFF);
     saveg_write8((leveltime >> 8) & 0xFF);
     saveg_write8(leveltime & 0xFF);
+
+    saveg_write32(rndseed);
 }
 
 //
@@ -1689,6 +1692,8 @@ dboolean P_ReadSaveGameHeader(char *description)
     c = saveg_read8();
     leveltime = (a << 16) + (b << 8) + c;
 
+    rndseed = saveg_read32();
+
     return true;
 }
 
@@ -1855,20 +1860,30 @@ void P_ArchiveThinkers(void)
         saveg_write_mobj_t((mobj_t *)th);
     }
 
-    // save off the bloodsplats
+    // save off the bloodsplats, in the same layout as a mobj
     for (i = 0; i < numsectors; ++i)
     {
-        mobj_t   *mo = sectors[i].thinglist;
+        bloodsplat_t    *splat = sectors[i].splatlist;
 
-        while (mo)
+        while (splat)
         {
-            if (mo->type == MT_BLOODSPLAT)
-            {
-                saveg_write8(tc_bloodsplat);
-                saveg_write_pad();
-                saveg_write_mobj_t(mo);
-            }
-            mo = mo->snext;
+            mobj_t  mo;
+
+            memset(&mo, 0, sizeof(mo));
+            mo.x = splat->x;
+            mo.y = splat->y;
+            mo.type = MT_BLOODSPLAT;
+            mo.sprite = SPR_BLD2;
+            mo.frame = splat->frame;
+            mo.state = states;
+            mo.flags = ((splat->flags & BSF_FUZZ) ? MF_FUZZ : 0);
+            mo.flags2 = (MF2_DONOTMAP | ((splat->flags & BSF_MIRRORED) ? MF2_MIRRORED : 0));
+            mo.blood = splat->blood;
+
+            saveg_write8(tc_bloodsplat);
+            saveg_write_pad();
+            saveg_write_mobj_t(&mo);
+            splat = splat->snext;
         }
     }
 
@@ -1916,7 +1931,7 @@ void P_UnArchiveThinkers(void)
 
     P_InitThinkers();
 
-    // remove the remaining bloodsplats and shadows
+    // remove the remaining shadows and bloodsplats
     for (i = 0; i < numsectors; ++i)
     {
         mobj_t   *mo = sectors[i].thinglist;
@@ -1927,7 +1942,7 @@ void P_UnArchiveThinkers(void)
             mo = mo->snext;
         }
     }
-    r_bloodsplats_total = 0;
+    P_ClearBloodSplats();
 
     // read in saved thinkers
     while (1)
@@ -1942,7 +1957,7 @@ void P_UnArchiveThinkers(void)
 
             case tc_mobj:
                 saveg_read_pad();
-                mobj = Z_Malloc(sizeof(*mobj), PU_LEVEL, NULL);
+                mobj = Z_PoolCalloc(&mobjpool);
                 saveg_read_mobj_t(mobj);
 
                 P_SetThingPosition(mobj);
@@ -1963,27 +1978,18 @@ void P_UnArchiveThinkers(void)
                 break;
 
             case tc_bloodsplat:
+            {
+                mobj_t  mo;
+
                 saveg_read_pad();
-                mobj = Z_Malloc(sizeof(*mobj), PU_LEVEL, NULL);
-                saveg_read_mobj_t(mobj);
+                saveg_read_mobj_t(&mo);
 
                 if (r_bloodsplats_total < r_bloodsplats_max)
-                {
-                    P_SetThingPosition(mobj);
-                    mobj->info = &mobjinfo[mobj->type];
-
-                    if (mobj->blood == FUZZYBLOOD)
-                    {
-                        mobj->flags = MF_FUZZ;
-                        mobj->colfunc = fuzzcolfunc;
-                    }
-                    else
-                        mobj->colfunc = bloodsplatcolfunc;
-                    mobj->projectfunc = R_ProjectBloodSplat;
-
-                    ++r_bloodsplats_total;
-                }
+                    P_AddBloodSplat(mo.x, mo.y, R_PointInSubsector(mo.x, mo.y)->sector, mo.blood,
+                        mo.frame & 7, ((mo.blood == FUZZYBLOOD ? BSF_FUZZ : 0)
+                        | ((mo.flags2 & MF2_MIRRORED) ? BSF_MIRRORED : 0)));
                 break;
+            }
 
             default:
                 I_Error("P_UnArchiveThinkers: Unknown tclass %i in savegame", tclass);
@@ -2238,7 +2244,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_ceiling:
                 saveg_read_pad();
-                ceiling = Z_Malloc(sizeof(*ceiling), PU_LEVEL, NULL);
+                ceiling = Z_PoolCalloc(&ceilingpool);
                 saveg_read_ceiling_t(ceiling);
                 ceiling->sector->ceilingdata = ceiling;
                 ceiling->thinker.function = T_MoveCeiling;
@@ -2248,7 +2254,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_door:
                 saveg_read_pad();
-                door = Z_Malloc(sizeof(*door), PU_LEVEL, NULL);
+                door = Z_PoolCalloc(&doorpool);
                 saveg_read_vldoor_t(door);
                 door->sector->ceilingdata = door;
                 door->thinker.function = T_VerticalDoor;
@@ -2257,7 +2263,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_floor:
                 saveg_read_pad();
-                floor = Z_Malloc(sizeof(*floor), PU_LEVEL, NULL);
+                floor = Z_PoolCalloc(&floorpool);
                 saveg_read_floormove_t(floor);
                 floor->sector->floordata = floor;
                 floor->thinker.function = T_MoveFloor;
@@ -2266,7 +2272,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_plat:
                 saveg_read_pad();
-                plat = Z_Malloc(sizeof(*plat), PU_LEVEL, NULL);
+                plat = Z_PoolCalloc(&platpool);
                 saveg_read_plat_t(plat);
                 plat->sector->floordata = plat;
                 P_AddThinker(&plat->thinker);
@@ -2275,7 +2281,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_flash:
                 saveg_read_pad();
-                flash = Z_Malloc(sizeof(*flash), PU_LEVEL, NULL);
+                flash = Z_PoolCalloc(&lightflashpool);
                 saveg_read_lightflash_t(flash);
                 flash->thinker.function = T_LightFlash;
                 P_AddThinker(&flash->thinker);
@@ -2283,7 +2289,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_strobe:
                 saveg_read_pad();
-                strobe = Z_Malloc(sizeof(*strobe), PU_LEVEL, NULL);
+                strobe = Z_PoolCalloc(&strobepool);
                 saveg_read_strobe_t(strobe);
                 strobe->thinker.function = T_StrobeFlash;
                 P_AddThinker(&strobe->thinker);
@@ -2291,7 +2297,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_glow:
                 saveg_read_pad();
-                glow = Z_Malloc(sizeof(*glow), PU_LEVEL, NULL);
+                glow = Z_PoolCalloc(&glowpool);
                 saveg_read_glow_t(glow);
                 glow->thinker.function = T_Glow;
                 P_AddThinker(&glow->thinker);
@@ -2299,7 +2305,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_fireflicker:
                 saveg_read_pad();
-                fireflicker = Z_Malloc(sizeof(*fireflicker), PU_LEVEL, NULL);
+                fireflicker = Z_PoolCalloc(&fireflickerpool);
                 saveg_read_fireflicker_t(fireflicker);
                 fireflicker->thinker.function = T_FireFlicker;
                 P_AddThinker(&fireflicker->thinker);
@@ -2307,7 +2313,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_elevator:
                 saveg_read_pad();
-                elevator = Z_Malloc(sizeof(*elevator), PU_LEVEL, NULL);
+                elevator = Z_PoolCalloc(&elevatorpool);
                 saveg_read_elevator_t(elevator);
                 elevator->sector->ceilingdata = elevator;
                 elevator->thinker.function = T_MoveElevator;
@@ -2316,7 +2322,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_scroll:
                 saveg_read_pad();
-                scroll = Z_Malloc(sizeof(*scroll), PU_LEVEL, NULL);
+                scroll = Z_PoolCalloc(&scrollpool);
                 saveg_read_scroll_t(scroll);
                 scroll->thinker.function = T_Scroll;
                 P_AddThinker(&scroll->thinker);
@@ -2324,7 +2330,7 @@ void P_UnArchiveSpecials(void)
 
             case tc_pusher:
                 saveg_read_pad();
-                pusher = Z_Malloc(sizeof(*pusher), PU_LEVEL, NULL);
+                pusher = Z_PoolCalloc(&pusherpool);
                 saveg_read_pusher_t(pusher);
                 pusher->thinker.function = T_Pusher;
                 pusher->source = P_GetPushThing(pusher->affectee);
@@ -44,6 +44,7 @@
 #include "doomstat.h"
 #include "i_swap.h"
 #include "i_system.h"
+#include "i_timer.h"
 #include "m_argv.h"
 #include "m_bbox.h"
 #include "m_menu.h"
@@ -229,13 +230,26 @@ static fixed_t GetOffset(vertex_t *v1, vertex_t *v2)
     return ((fixed_t)(sqrt(dx * dx + dy * dy)) << FRACBITS);
 }
 
+// Level geometry is kept as PU_STATIC so it can be reused when the same level
+// is loaded again, and is counted as ZO_LEVEL in memstats.
+static void *P_CallocLevel(size_t n1, size_t n2)
+{
+    void        *p = Z_Calloc(n1, n2, PU_STATIC, NULL);
+
+    Z_ChangeOwner(p, ZO_LEVEL);
+    return p;
+}
+
 // e6y: Smart malloc
 // Used by P_SetupLevel() for smart data loading
 // Do nothing if level is the same
 static void *malloc_IfSameLevel(void *p, size_t size)
 {
     if (!samelevel || !p)
-        return malloc(size);
+    {
+        p = Z_Malloc(size, PU_STATIC, NULL);
+        Z_ChangeOwner(p, ZO_LEVEL);
+    }
     return p;
 }
 
@@ -245,7 +259,7 @@ static void *malloc_IfSameLevel(void *p, size_t size)
 static void *calloc_IfSameLevel(void *p, size_t n1, size_t n2)
 {
     if (!samelevel)
-        return calloc(n1, n2);
+        return P_CallocLevel(n1, n2);
     else
     {
         memset(p, 0, n1 * n2);
@@ -977,7 +991,7 @@ static void P_LoadZNodes(int lump)
             newvertarray = vertexes;
         else
         {
-            newvertarray = calloc(orgVerts + newVerts, sizeof(vertex_t));
+            newvertarray = P_CallocLevel(orgVerts + newVerts, sizeof(vertex_t));
             memcpy(newvertarray, vertexes, orgVerts * sizeof(vertex_t));
         }
 
@@ -997,7 +1011,7 @@ static void P_LoadZNodes(int lump)
                 lines[i].v1 = lines[i].v1 - vertexes + newvertarray;
                 lines[i].v2 = lines[i].v2 - vertexes + newvertarray;
             }
-            free(vertexes);
+            Z_Free(vertexes);
             vertexes = newvertarray;
             numvertexes = orgVerts + newVerts;
         }
@@ -1088,7 +1102,7 @@ void P_LoadThings(int lump)
     sizethings = W_LumpLength(lump);
     numthings = sizethings / sizeof(mapthing_t);
 
-    srand(numthings);
+    M_Seed(numthings);
 
     for (i = 0; i < numthings; i++)
     {
@@ -1512,7 +1526,7 @@ static void P_CreateBlockMap(void)
                 bmap_t  *bp = &bmap[b];
 
                 // Increase size of allocated list if necessary
-                if (bp->n >= bp->nalloc && !(bp->list = Z_Realloc(bp->list,
+                if (bp->n >= bp->nalloc && !(bp->list = realloc(bp->list,
                     (bp->nalloc = bp->nalloc ? bp->nalloc * 2 : 8) * sizeof(*bp->list))))
                     I_Error("Unable to create blockmap.");
 
@@ -1625,7 +1639,7 @@ void P_LoadBlockMap(int lump)
             blockmaplump[i] = (t == -1 ? -1l : ((uint32_t)t & 0xFFFF));
         }
 
-        Z_Free(wadblockmaplump);
+        W_ReleaseLumpNum(lump);
 
         // Read the header
         bmaporgx = blockmaplump[0] << FRACBITS;
@@ -1653,6 +1667,8 @@ void RejectOverrun(int rejectlump, const byte **rejectmatrix, int totallines)
         // PU_LEVEL => will be freed on level exit
         byte    *newreject = Z_Malloc(required, PU_LEVEL, NULL);
 
+        Z_ChangeOwner(newreject, ZO_LEVEL);
+
         *rejectmatrix = memmove(newreject, *rejectmatrix, length);
 
         memset(newreject + length, 0, required - length);
@@ -1736,6 +1752,8 @@ static int P_GroupLines(void)
     {
         line_t  **linebuffer = Z_Malloc(total * sizeof(line_t *), PU_LEVEL, NULL);
 
+        Z_ChangeOwner(linebuffer, ZO_LEVEL);
+
         for (i = 0, sector = sectors; i < numsectors; i++, sector++)
         {
             sector->lines = linebuffer;
@@ -2069,6 +2087,35 @@ static mapformat_t P_CheckMapFormat(int lumpnum)
 extern dboolean idclev;
 extern dboolean massacre;
 
+uint64_t        setuptimes[NUMSETUPPHASES];
+uint64_t        setuptotaltime;
+
+char *setupphasenames[NUMSETUPPHASES] =
+{
+    "Geometry",
+    "Blockmap",
+    "Nodes",
+    "P_GroupLines",
+    "Reject",
+    "Things",
+    "Specials",
+    "R_PrecacheLevel"
+};
+
+static uint64_t setupphasestart;
+
+//
+// P_EndSetupPhase
+// Adds the time since the previous phase ended to the given phase.
+//
+static void P_EndSetupPhase(setupphase_t phase)
+{
+    uint64_t    now = I_GetTimeUS();
+
+    setuptimes[phase] += now - setupphasestart;
+    setupphasestart = now;
+}
+
 //
 // P_SetupLevel
 //
@@ -2076,6 +2123,10 @@ void P_SetupLevel(int ep, int map)
 {
     char        lumpname[6];
     int         lumpnum;
+    uint64_t    start = I_GetTimeUS();
+    int         rejectpadding;
+
+    memset(setuptimes, 0, sizeof(setuptimes));
 
     totalkills = totalitems = totalsecret = 0;
     memset(monstercount, 0, sizeof(int) * NUMMOBJTYPES);
@@ -2110,6 +2161,9 @@ void P_SetupLevel(int ep, int map)
     else
         lumpnum = W_GetNumForName(lumpname);
 
+    // The map's lumps are read one after the other, so ask for all of them now
+    W_PrefetchLumps(lumpnum, ML_BLOCKMAP + 1);
+
     mapformat = P_CheckMapFormat(lumpnum);
 
     canmodify = ((W_CheckMultipleLumps(lumpname) == 1 || gamemission == pack_nerve
@@ -2136,17 +2190,19 @@ void P_SetupLevel(int ep, int map)
 
     if (!samelevel)
     {
-        free(segs);
-        free(nodes);
-        free(subsectors);
-        free(blocklinks);
-        free(blockmaplump);
-        free(lines);
-        free(sides);
-        free(sectors);
-        free(vertexes);
+        Z_Free(segs);
+        Z_Free(nodes);
+        Z_Free(subsectors);
+        Z_Free(blocklinks);
+        Z_Free(blockmaplump);
+        Z_Free(lines);
+        Z_Free(sides);
+        Z_Free(sectors);
+        Z_Free(vertexes);
     }
 
+    setupphasestart = I_GetTimeUS();
+
     // note: most of this ordering is important
     P_LoadVertexes(lumpnum + ML_VERTEXES);
     P_LoadSectors(lumpnum + ML_SECTORS);
@@ -2154,11 +2210,13 @@ void P_SetupLevel(int ep, int map)
     P_LoadLineDefs(lumpnum + ML_LINEDEFS);
     P_LoadSideDefs2(lumpnum + ML_SIDEDEFS);
     P_LoadLineDefs2(lumpnum + ML_LINEDEFS);
+    P_EndSetupPhase(SETUP_GEOMETRY);
 
     if (!samelevel)
         P_LoadBlockMap(lumpnum + ML_BLOCKMAP);
     else
         memset(blocklinks, 0, bmapwidth * bmapheight * sizeof(*blocklinks));
+    P_EndSetupPhase(SETUP_BLOCKMAP);
 
     if (mapformat == ZDBSPX)
         P_LoadZNodes(lumpnum + ML_NODES);
@@ -2174,43 +2232,57 @@ void P_SetupLevel(int ep, int map)
         P_LoadNodes(lumpnum + ML_NODES);
         P_LoadSegs(lumpnum + ML_SEGS);
     }
+    P_EndSetupPhase(SETUP_NODES);
 
     // reject loading and underflow padding separated out into new function
     // P_GroupLines modified to return a number the underflow padding needs
-    P_LoadReject(lumpnum, P_GroupLines());
+    rejectpadding = P_GroupLines();
+    P_EndSetupPhase(SETUP_GROUPLINES);
+
+    P_LoadReject(lumpnum, rejectpadding);
+    P_EndSetupPhase(SETUP_REJECT);
 
     P_RemoveSlimeTrails();
 
     P_CalcSegsLength();
+    P_EndSetupPhase(SETUP_NODES);
 
-    r_bloodsplats_total = 0;
-    memset(bloodsplats, 0, sizeof(mobj_t *) * r_bloodsplats_max);
+    P_InitBloodSplats();
 
     pathpointnum = 0;
     pathpointnum_max = 0;
 
+    R_ResetRenderCounters();
+    I_ResetFrameTimes();
+
     massacre = false;
 
     P_SetLiquids();
     P_GetMapLiquids((ep - 1) * 10 + map);
     P_GetMapNoLiquids((ep - 1) * 10 + map);
 
+    setupphasestart = I_GetTimeUS();
     P_LoadThings(lumpnum + ML_THINGS);
 
     P_InitCards(&players[0]);
+    P_EndSetupPhase(SETUP_THINGS);
 
     // set up world state
     P_SpawnSpecials();
 
     P_MapEnd();
+    P_EndSetupPhase(SETUP_SPECIALS);
 
     // preload graphics
     R_PrecacheLevel();
+    P_EndSetupPhase(SETUP_PRECACHE);
 
     S_Start();
 
     if (gamemode != shareware)
         S_ParseMusInfo(lumpname);
+
+    setuptotaltime = I_GetTimeUS() - start;
 }
 
 int     liquidlumps = 0;
@@ -39,6 +39,27 @@
 #if !defined(__P_SETUP_H__)
 #define __P_SETUP_H__
 
+// phases of P_SetupLevel that are timed
+typedef enum
+{
+    SETUP_GEOMETRY,
+    SETUP_BLOCKMAP,
+    SETUP_NODES,
+    SETUP_GROUPLINES,
+    SETUP_REJECT,
+    SETUP_THINGS,
+    SETUP_SPECIALS,
+    SETUP_PRECACHE,
+    NUMSETUPPHASES
+} setupphase_t;
+
+// time taken by each phase of the last call to P_SetupLevel, and by all of
+// it, in microseconds
+extern uint64_t setuptimes[NUMSETUPPHASES];
+extern uint64_t setuptotaltime;
+
+extern char     *setupphasenames[NUMSETUPPHASES];
+
 void P_SetupLevel(int ep, int map);
 void P_MapName(int ep, int map);
 
@@ -37,7 +37,12 @@
 */
 
 #include "m_bbox.h"
+#include "i_timer.h"
 #include "p_local.h"
+#include "p_tick.h"
+
+uint64_t        checksighttime;
+unsigned int    checksightcalls;
 
 //
 // P_CheckSight
@@ -232,7 +237,7 @@ static dboolean P_CrossBSPNode(int bspnum)
 //  if a straight line between t1 and t2 is unobstructed.
 // Uses REJECT.
 //
-dboolean P_CheckSight(mobj_t *t1, mobj_t *t2)
+static dboolean P_DoCheckSight(mobj_t *t1, mobj_t *t2)
 {
     const sector_t      *s1 = t1->subsector->sector;
     const sector_t      *s2 = t2->subsector->sector;
@@ -303,3 +308,18 @@ dboolean P_CheckSight(mobj_t *t1, mobj_t *t2)
     // the head node is the last node output
     return P_CrossBSPNode(numnodes - 1);
 }
+
+dboolean P_CheckSight(mobj_t *t1, mobj_t *t2)
+{
+    if (playsimtiming)
+    {
+        uint64_t        start = I_GetTimeUS();
+        dboolean        result = P_DoCheckSight(t1, t2);
+
+        checksighttime += I_GetTimeUS() - start;
+        ++checksightcalls;
+        return result;
+    }
+
+    return P_DoCheckSight(t1, t2);
+}
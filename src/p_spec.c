@@ -216,7 +216,7 @@ void P_SetLiquids(void)
         {
             int j;
 
-            if (W_CheckNumForName(animdefs[i].startname) == -1)
+            if (R_CheckFlatNumForName(animdefs[i].startname) == -1)
                 continue;
 
             lastanim->picnum = R_FlatNumForName(animdefs[i].endname);
@@ -1991,7 +1991,7 @@ dboolean EV_DoDonut(line_t *line)
             rtn = true;
 
             // Spawn rising slime
-            floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+            floor = Z_PoolCalloc(&floorpool);
             P_AddThinker(&floor->thinker);
             s2->floordata = floor;
             floor->thinker.function = T_MoveFloor;
@@ -2006,7 +2006,7 @@ dboolean EV_DoDonut(line_t *line)
             floor->stopsound = (floor->sector->floorheight != floor->floordestheight);
 
             // Spawn lowering donut-hole
-            floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+            floor = Z_PoolCalloc(&floorpool);
             P_AddThinker(&floor->thinker);
             s1->floordata = floor;
             floor->thinker.function = T_MoveFloor;
@@ -2277,7 +2277,7 @@ void T_Scroll(scroll_t *s)
 //
 static void Add_Scroller(int type, fixed_t dx, fixed_t dy, int control, int affectee, int accel)
 {
-    scroll_t    *s = Z_Calloc(1, sizeof(*s), PU_LEVSPEC, NULL);
+    scroll_t    *s = Z_PoolCalloc(&scrollpool);
 
     s->thinker.function = T_Scroll;
     s->type = type;
@@ -2551,7 +2551,7 @@ static void P_SpawnFriction(void)
 // Add a push thinker to the thinker list
 static void Add_Pusher(int type, int x_mag, int y_mag, mobj_t *source, int affectee)
 {
-    pusher_t    *p = Z_Calloc(1, sizeof(*p), PU_LEVSPEC, NULL);
+    pusher_t    *p = Z_PoolCalloc(&pusherpool);
 
     p->thinker.function = T_Pusher;
     p->source = source;
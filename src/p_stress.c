@@ -0,0 +1,521 @@
+/*
+========================================================================
+
+                           D O O M  R e t r o
+         The classic, refined DOOM source port. For Windows PC.
+
+========================================================================
+
+  Copyright © 1993-2012 id Software LLC, a ZeniMax Media company.
+  Copyright © 2013-2016 Brad Harding.
+
+  DOOM Retro is a fork of Chocolate DOOM.
+  For a list of credits, see the accompanying AUTHORS file.
+
+  This file is part of DOOM Retro.
+
+  DOOM Retro is free software: you can redistribute it and/or modify it
+  under the terms of the GNU General Public License as published by the
+  Free Software Foundation, either version 3 of the License, or (at your
+  option) any later version.
+
+  DOOM Retro is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with DOOM Retro. If not, see <http://www.gnu.org/licenses/>.
+
+  DOOM is a registered trademark of id Software LLC, a ZeniMax Media
+  company, in the US and/or other countries and is used without
+  permission. All other trademarks are the property of their respective
+  holders. DOOM Retro is in no way affiliated with nor endorsed by
+  id Software.
+
+========================================================================
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "c_console.h"
+#include "doomstat.h"
+#include "g_game.h"
+#include "i_swap.h"
+#include "i_system.h"
+#include "i_timer.h"
+#include "m_bbox.h"
+#include "m_misc.h"
+#include "p_local.h"
+#include "p_setup.h"
+#include "p_stress.h"
+#include "p_tick.h"
+#include "w_wad.h"
+
+#define ARENACELLSIZE   512
+#define MAZECELLSIZE    128
+#define THINGSPACING    64
+
+// segs and sidedefs are indexed with 16 bits, and there are 4 of each per sector
+#define MAXCELLS        127
+#define MAXMONSTERS     100000
+
+#define NUMSTRESSLUMPS  11
+
+stressmode_t    stressmode = STRESS_NONE;
+int             stresssectors = 4096;
+int             stressmonsters = 10000;
+int             stresstics = TICRATE * 10;
+
+static int      columns;
+static int      rows;
+static int      cellsize;
+static int      thingcolumns;
+static int      numcells;
+static int      numstressthings;
+static int      numstresslines;
+
+static unsigned int     stressseed;
+
+void R_ExecuteSetViewSize(void);
+
+static int P_StressRandom(void)
+{
+    stressseed = stressseed * 1103515245 + 12345;
+    return ((stressseed >> 16) & 0x7FFF);
+}
+
+static __inline int P_StressVertex(int x, int y)
+{
+    return (y * (columns + 1) + x);
+}
+
+static __inline int P_StressHorizontalLine(int x, int y)
+{
+    return (y * columns + x);
+}
+
+static __inline int P_StressVerticalLine(int x, int y)
+{
+    return (columns * (rows + 1) + y * (columns + 1) + x);
+}
+
+static void P_StressName(char *dest, const char *name)
+{
+    strncpy(dest, name, 8);
+}
+
+//
+// P_StressLayout
+// Work out how many cells the level is divided into. An arena is made just
+//  big enough to hold every monster on a grid, while a maze has one small
+//  sector per cell.
+//
+static void P_StressLayout(void)
+{
+    if (stressmode == STRESS_ARENA)
+    {
+        stressmonsters = BETWEEN(0, stressmonsters, MAXMONSTERS);
+        thingcolumns = (int)ceil(sqrt(stressmonsters + 1.0));
+        cellsize = ARENACELLSIZE;
+        columns = MAX(2, (thingcolumns * THINGSPACING + cellsize - 1) / cellsize);
+        rows = columns;
+    }
+    else
+    {
+        stresssectors = BETWEEN(2, stresssectors, MAXCELLS * MAXCELLS);
+        cellsize = MAZECELLSIZE;
+        columns = BETWEEN(2, (int)ceil(sqrt((double)stresssectors)), MAXCELLS);
+        rows = BETWEEN(1, (stresssectors + columns - 1) / columns, MAXCELLS);
+    }
+
+    numcells = columns * rows;
+    numstresslines = columns * (rows + 1) + (columns + 1) * rows;
+
+    // each maze cell has room for 4 things
+    if (stressmode == STRESS_MAZE)
+        stressmonsters = BETWEEN(0, stressmonsters, numcells * 4 - 1);
+
+    numstressthings = stressmonsters + 1;
+}
+
+static void P_StressThingPosition(int i, short *x, short *y)
+{
+    if (stressmode == STRESS_ARENA)
+    {
+        *x = THINGSPACING / 2 + i % thingcolumns * THINGSPACING;
+        *y = THINGSPACING / 2 + i / thingcolumns * THINGSPACING;
+    }
+    else
+    {
+        int cell = i % numcells;
+        int spot = i / numcells;
+
+        *x = cell % columns * cellsize + cellsize / 4 + (spot & 1) * cellsize / 2;
+        *y = cell / columns * cellsize + cellsize / 4 + (spot >> 1) * cellsize / 2;
+    }
+}
+
+//
+// P_StressNode
+// Build the BSP tree by repeatedly halving a rectangle of cells along its
+//  longest side until only a single cell, which is a subsector, is left.
+//  Children are added before their parent so the root node is last.
+//
+static unsigned short P_StressNode(mapnode_t *nodes, int *numnodes, int x1, int y1, int x2, int y2)
+{
+    mapnode_t       *node;
+    unsigned short  children[2];
+    int             boxes[2][4];
+    int             i;
+
+    if (x2 - x1 == 1 && y2 - y1 == 1)
+        return ((y1 * columns + x1) | 0x8000);
+
+    if (x2 - x1 >= y2 - y1)
+    {
+        // vertical partition line pointing up, so the right half is in front
+        int xm = (x1 + x2) / 2;
+
+        children[0] = P_StressNode(nodes, numnodes, xm, y1, x2, y2);
+        children[1] = P_StressNode(nodes, numnodes, x1, y1, xm, y2);
+
+        node = &nodes[*numnodes];
+        node->x = SHORT(xm * cellsize);
+        node->y = SHORT(y1 * cellsize);
+        node->dx = 0;
+        node->dy = SHORT((y2 - y1) * cellsize);
+
+        boxes[0][BOXLEFT] = xm;
+        boxes[0][BOXRIGHT] = x2;
+        boxes[1][BOXLEFT] = x1;
+        boxes[1][BOXRIGHT] = xm;
+        boxes[0][BOXBOTTOM] = boxes[1][BOXBOTTOM] = y1;
+        boxes[0][BOXTOP] = boxes[1][BOXTOP] = y2;
+    }
+    else
+    {
+        // horizontal partition line pointing right, so the lower half is in front
+        int ym = (y1 + y2) / 2;
+
+        children[0] = P_StressNode(nodes, numnodes, x1, y1, x2, ym);
+        children[1] = P_StressNode(nodes, numnodes, x1, ym, x2, y2);
+
+        node = &nodes[*numnodes];
+        node->x = SHORT(x1 * cellsize);
+        node->y = SHORT(ym * cellsize);
+        node->dx = SHORT((x2 - x1) * cellsize);
+        node->dy = 0;
+
+        boxes[0][BOXBOTTOM] = y1;
+        boxes[0][BOXTOP] = ym;
+        boxes[1][BOXBOTTOM] = ym;
+        boxes[1][BOXTOP] = y2;
+        boxes[0][BOXLEFT] = boxes[1][BOXLEFT] = x1;
+        boxes[0][BOXRIGHT] = boxes[1][BOXRIGHT] = x2;
+    }
+
+    for (i = 0; i < 2; ++i)
+    {
+        int j;
+
+        node->children[i] = SHORT(children[i]);
+
+        for (j = 0; j < 4; ++j)
+            node->bbox[i][j] = SHORT(boxes[i][j] * cellsize);
+    }
+
+    return (unsigned short)(*numnodes)++;
+}
+
+//
+// P_BuildStressWad
+// Build a PWAD in memory containing a single map made from a grid of
+//  square sectors.
+//
+static byte *P_BuildStressWad(char *mapname, unsigned int *length)
+{
+    const char  *lumpnames[NUMSTRESSLUMPS] =
+    {
+        mapname, "THINGS", "LINEDEFS", "SIDEDEFS", "VERTEXES", "SEGS", "SSECTORS", "NODES",
+        "SECTORS", "REJECT", "BLOCKMAP"
+    };
+    int         lumpsizes[NUMSTRESSLUMPS];
+    int         lumpoffsets[NUMSTRESSLUMPS];
+    int         numvertices = (columns + 1) * (rows + 1);
+    int         numsegs = numcells * 4;
+    int         numnodes = 0;
+    int         size = 12;
+    byte        *wad;
+    filelump_t  *directory;
+    mapthing_t  *things;
+    maplinedef_t    *lines;
+    mapsidedef_t    *sides;
+    mapvertex_t *vertices;
+    mapseg_t    *segs;
+    mapsubsector_t  *subsectors;
+    mapsector_t *sectors;
+    int         i;
+    int         x, y;
+
+    lumpsizes[0] = 0;
+    lumpsizes[1] = numstressthings * sizeof(mapthing_t);
+    lumpsizes[2] = numstresslines * sizeof(maplinedef_t);
+    lumpsizes[3] = numsegs * sizeof(mapsidedef_t);
+    lumpsizes[4] = numvertices * sizeof(mapvertex_t);
+    lumpsizes[5] = numsegs * sizeof(mapseg_t);
+    lumpsizes[6] = numcells * sizeof(mapsubsector_t);
+    lumpsizes[7] = (numcells - 1) * sizeof(mapnode_t);
+    lumpsizes[8] = numcells * sizeof(mapsector_t);
+
+    // an empty REJECT and BLOCKMAP are built when the map is loaded
+    lumpsizes[9] = 0;
+    lumpsizes[10] = 0;
+
+    for (i = 0; i < NUMSTRESSLUMPS; ++i)
+    {
+        lumpoffsets[i] = size;
+        size += lumpsizes[i];
+    }
+
+    wad = calloc(1, size + NUMSTRESSLUMPS * sizeof(filelump_t));
+    if (!wad)
+        I_Error("Unable to allocate memory for the generated map.");
+
+    memcpy(wad, "PWAD", 4);
+    *(int *)(wad + 4) = LONG(NUMSTRESSLUMPS);
+    *(int *)(wad + 8) = LONG(size);
+
+    directory = (filelump_t *)(wad + size);
+
+    for (i = 0; i < NUMSTRESSLUMPS; ++i)
+    {
+        directory[i].filepos = LONG(lumpoffsets[i]);
+        directory[i].size = LONG(lumpsizes[i]);
+        strncpy(directory[i].name, lumpnames[i], 8);
+    }
+
+    things = (mapthing_t *)(wad + lumpoffsets[1]);
+    lines = (maplinedef_t *)(wad + lumpoffsets[2]);
+    sides = (mapsidedef_t *)(wad + lumpoffsets[3]);
+    vertices = (mapvertex_t *)(wad + lumpoffsets[4]);
+    segs = (mapseg_t *)(wad + lumpoffsets[5]);
+    subsectors = (mapsubsector_t *)(wad + lumpoffsets[6]);
+
+    // things: player 1 start, then the monsters
+    for (i = 0; i < numstressthings; ++i)
+    {
+        short   tx, ty;
+
+        P_StressThingPosition(i, &tx, &ty);
+        things[i].x = SHORT(tx);
+        things[i].y = SHORT(ty);
+        things[i].angle = SHORT(i ? i * 45 % 360 : 45);
+        things[i].type = SHORT(i ? 3004 : 1);
+        things[i].options = SHORT(7);
+    }
+
+    // vertices
+    for (y = 0; y <= rows; ++y)
+        for (x = 0; x <= columns; ++x)
+        {
+            vertices[P_StressVertex(x, y)].x = SHORT(x * cellsize);
+            vertices[P_StressVertex(x, y)].y = SHORT(y * cellsize);
+        }
+
+    for (i = 0; i < numstresslines; ++i)
+        lines[i].sidenum[0] = lines[i].sidenum[1] = 0xFFFF;
+
+    // subsectors and segs: each cell is a subsector with a seg along each of its edges,
+    // going clockwise so the cell is on the right. The sidedef of each seg has the same
+    // index as the seg. Every linedef points up or right, except for those along the
+    // bottom and right of the map, which are reversed so their front faces in.
+    for (y = 0; y < rows; ++y)
+        for (x = 0; x < columns; ++x)
+        {
+            int cell = y * columns + x;
+            int v[4] =
+            {
+                P_StressVertex(x, y), P_StressVertex(x, y + 1),
+                P_StressVertex(x + 1, y + 1), P_StressVertex(x + 1, y)
+            };
+            int linenums[4] =
+            {
+                P_StressVerticalLine(x, y), P_StressHorizontalLine(x, y + 1),
+                P_StressVerticalLine(x + 1, y), P_StressHorizontalLine(x, y)
+            };
+            int angles[4] = { 0x4000, 0, -0x4000, -0x8000 };
+            int sidenums[4] = { 0, 0, (x + 1 < columns), (y > 0) };
+
+            subsectors[cell].numsegs = SHORT(4);
+            subsectors[cell].firstseg = SHORT(cell * 4);
+
+            for (i = 0; i < 4; ++i)
+            {
+                mapseg_t        *seg = &segs[cell * 4 + i];
+                maplinedef_t    *line = &lines[linenums[i]];
+
+                seg->v1 = SHORT(v[i]);
+                seg->v2 = SHORT(v[(i + 1) & 3]);
+                seg->angle = SHORT(angles[i]);
+                seg->linedef = SHORT(linenums[i]);
+                seg->side = SHORT(sidenums[i]);
+                seg->offset = 0;
+
+                line->sidenum[sidenums[i]] = SHORT(cell * 4 + i);
+                if (!sidenums[i])
+                {
+                    line->v1 = seg->v1;
+                    line->v2 = seg->v2;
+                }
+
+                sides[cell * 4 + i].sector = SHORT(cell);
+            }
+        }
+
+    // linedefs: walls around the outside, and some blocking lines inside a maze
+    stressseed = 1;
+
+    for (i = 0; i < numstresslines; ++i)
+    {
+        if (lines[i].sidenum[1] == 0xFFFF)
+            lines[i].flags = SHORT(ML_BLOCKING);
+        else if (stressmode == STRESS_MAZE && !(P_StressRandom() % 3))
+            lines[i].flags = SHORT(ML_TWOSIDED | ML_BLOCKING);
+        else
+            lines[i].flags = SHORT(ML_TWOSIDED);
+    }
+
+    // sidedefs
+    for (i = 0; i < numsegs; ++i)
+    {
+        mapsidedef_t    *side = &sides[i];
+
+        if (lines[SHORT(segs[i].linedef)].sidenum[1] == 0xFFFF)
+        {
+            P_StressName(side->toptexture, "-");
+            P_StressName(side->bottomtexture, "-");
+            P_StressName(side->midtexture, "STARTAN3");
+        }
+        else
+        {
+            P_StressName(side->toptexture, "STARTAN3");
+            P_StressName(side->bottomtexture, "STARTAN3");
+            P_StressName(side->midtexture, "-");
+        }
+    }
+
+    // nodes
+    P_StressNode((mapnode_t *)(wad + lumpoffsets[7]), &numnodes, 0, 0, columns, rows);
+
+    // sectors: a maze has steps no higher than 24 units that monsters can climb
+    sectors = (mapsector_t *)(wad + lumpoffsets[8]);
+
+    for (y = 0; y < rows; ++y)
+        for (x = 0; x < columns; ++x)
+        {
+            mapsector_t *sector = &sectors[y * columns + x];
+
+            if (stressmode == STRESS_ARENA)
+            {
+                sector->floorheight = 0;
+                sector->ceilingheight = SHORT(256);
+                sector->lightlevel = SHORT(160 + ((x + y) & 1) * 32);
+            }
+            else
+            {
+                sector->floorheight = SHORT(((x * 3 + y * 5) & 3) * 8);
+                sector->ceilingheight = SHORT(128);
+                sector->lightlevel = SHORT(128 + ((x ^ y) & 3) * 32);
+            }
+
+            P_StressName(sector->floorpic, "FLOOR4_8");
+            P_StressName(sector->ceilingpic, "CEIL3_5");
+        }
+
+    *length = size + NUMSTRESSLUMPS * sizeof(filelump_t);
+    return wad;
+}
+
+//
+// P_RunStressTest
+//
+void P_RunStressTest(void)
+{
+    char        mapname[6];
+    byte        *wad;
+    unsigned int    length;
+    int         mobjs = 0;
+    int         tics;
+    thinker_t   *th;
+    uint64_t    start;
+    uint64_t    playsimtime = 0;
+    uint64_t    rendertime = 0;
+    dboolean    oldcapfps = vid_capfps;
+
+    P_StressLayout();
+
+    if (gamemode == commercial)
+        M_StringCopy(mapname, "MAP01", sizeof(mapname));
+    else
+        M_StringCopy(mapname, "E1M1", sizeof(mapname));
+
+    wad = P_BuildStressWad(mapname, &length);
+    W_AddMemoryFile((stressmode == STRESS_ARENA ? "STRESSARENA.WAD" : "STRESSMAZE.WAD"), wad,
+        length);
+
+    G_InitNew(startskill, 1, 1);
+
+    // keep the monsters busy chasing the player for the whole test
+    players[0].cheats |= CF_GODMODE;
+
+    for (th = thinkerclasscap[th_mobj].cnext; th != &thinkerclasscap[th_mobj]; th = th->cnext)
+        ++mobjs;
+
+    // frames are rendered without interpolation
+    vid_capfps = true;
+    R_ExecuteSetViewSize();
+
+    runthinkerstime = 0;
+    maxrunthinkerstime = 0;
+    trymovetime = 0;
+    trymovecalls = 0;
+    checksighttime = 0;
+    checksightcalls = 0;
+    playsimtiming = true;
+
+    for (tics = 0; tics < stresstics; ++tics)
+    {
+        memset(&players[0].cmd, 0, sizeof(ticcmd_t));
+
+        start = I_GetTimeUS();
+        P_Ticker();
+        playsimtime += I_GetTimeUS() - start;
+        ++gametic;
+
+        start = I_GetTimeUS();
+        R_RenderPlayerView(&players[0]);
+        rendertime += I_GetTimeUS() - start;
+    }
+
+    playsimtiming = false;
+    vid_capfps = oldcapfps;
+    tics = MAX(1, tics);
+
+    C_Output("<b>%s</b> sectors, <b>%s</b> lines and <b>%s</b> mobjs were run for <b>%s</b> tics.",
+        commify(numsectors), commify(numlines), commify(mobjs), commify(tics));
+    C_Output("Each tic took <b>%.3f</b> milliseconds in the playsim, including <b>%.3f</b> in "
+        "P_RunThinkers(), <b>%.3f</b> in <b>%.0f</b> calls to P_CheckSight() and <b>%.3f</b> in "
+        "<b>%.0f</b> calls to P_TryMove(). R_RenderPlayerView() took <b>%.3f</b> milliseconds.",
+        playsimtime / 1000.0 / tics, runthinkerstime / 1000.0 / tics,
+        checksighttime / 1000.0 / tics, (double)checksightcalls / tics,
+        trymovetime / 1000.0 / tics, (double)trymovecalls / tics, rendertime / 1000.0 / tics);
+    printf("stress=%s sectors=%i lines=%i mobjs=%i tics=%i playsimus=%.1f runthinkersus=%.1f "
+        "checksights=%.1f checksightus=%.1f trymoves=%.1f trymoveus=%.1f renderus=%.1f\n",
+        (stressmode == STRESS_ARENA ? "arena" : "maze"), numsectors, numlines, mobjs, tics,
+        (double)playsimtime / tics, (double)runthinkerstime / tics,
+        (double)checksightcalls / tics, (double)checksighttime / tics,
+        (double)trymovecalls / tics, (double)trymovetime / tics, (double)rendertime / tics);
+}
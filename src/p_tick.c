@@ -37,7 +37,10 @@
 */
 
 #include "c_console.h"
+#include "d_loop.h"
 #include "doomstat.h"
+#include "i_timer.h"
+#include "m_profile.h"
 #include "p_local.h"
 #include "p_tick.h"
 #include "s_sound.h"
@@ -46,6 +49,24 @@
 int     leveltime;
 int     stat_time = 0;
 
+uint64_t        runthinkerstime;
+uint64_t        maxrunthinkerstime;
+dboolean        playsimtiming;
+
+// each type of thinker is allocated from its own pool
+zonepool_t      mobjpool = ZONEPOOL(mobj_t, PU_LEVEL, ZO_THINKER);
+zonepool_t      ceilingpool = ZONEPOOL(ceiling_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      doorpool = ZONEPOOL(vldoor_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      floorpool = ZONEPOOL(floormove_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      elevatorpool = ZONEPOOL(elevator_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      platpool = ZONEPOOL(plat_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      fireflickerpool = ZONEPOOL(fireflicker_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      lightflashpool = ZONEPOOL(lightflash_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      strobepool = ZONEPOOL(strobe_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      glowpool = ZONEPOOL(glow_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      scrollpool = ZONEPOOL(scroll_t, PU_LEVSPEC, ZO_THINKER);
+zonepool_t      pusherpool = ZONEPOOL(pusher_t, PU_LEVSPEC, ZO_THINKER);
+
 //
 // THINKERS
 // All thinkers should be allocated by Z_Malloc
@@ -111,6 +132,8 @@ void P_AddThinker(thinker_t *thinker)
 
     thinker->references = 0;    // killough 11/98: init reference counter to 0
 
+    Z_ChangeOwner(thinker, ZO_THINKER);
+
     // killough 8/29/98: set sentinel pointers, and then add to appropriate list
     thinker->cnext = thinker->cprev = NULL;
     P_UpdateThinker(thinker);
@@ -240,7 +263,22 @@ void P_Ticker(void)
 
     P_PlayerThink(&players[0]);
 
-    P_RunThinkers();
+    PROFILE_BEGIN(PROF_P_RUNTHINKERS);
+    if (nodraw || playsimtiming)
+    {
+        uint64_t        start = I_GetTimeUS();
+        uint64_t        elapsed;
+
+        P_RunThinkers();
+        elapsed = I_GetTimeUS() - start;
+        runthinkerstime += elapsed;
+        if (elapsed > maxrunthinkerstime)
+            maxrunthinkerstime = elapsed;
+    }
+    else
+        P_RunThinkers();
+    PROFILE_END(PROF_P_RUNTHINKERS);
+
     P_UpdateSpecials();
     P_RespawnSpecials();
 
@@ -39,12 +39,34 @@
 #if !defined(__P_TICK_H__)
 #define __P_TICK_H__
 
+#include "z_zone.h"
+
 #ifdef __GNUG__
 #pragma interface
 #endif
 
 void P_Ticker(void);
 
+// time spent in P_RunThinkers while running headless, in microseconds
+extern uint64_t         runthinkerstime;
+extern uint64_t         maxrunthinkerstime;
+
+// also time P_RunThinkers, P_CheckSight and P_TryMove during a stress test
+extern dboolean         playsimtiming;
+
+extern zonepool_t       mobjpool;
+extern zonepool_t       ceilingpool;
+extern zonepool_t       doorpool;
+extern zonepool_t       floorpool;
+extern zonepool_t       elevatorpool;
+extern zonepool_t       platpool;
+extern zonepool_t       fireflickerpool;
+extern zonepool_t       lightflashpool;
+extern zonepool_t       strobepool;
+extern zonepool_t       glowpool;
+extern zonepool_t       scrollpool;
+extern zonepool_t       pusherpool;
+
 void P_InitThinkers(void);
 void P_AddThinker(thinker_t *thinker);
 void P_RemoveThinker(thinker_t *thinker);
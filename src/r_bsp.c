@@ -629,6 +629,8 @@ static void R_Subsector(int num)
     int         count = sub->numlines;
     seg_t       *line = &segs[sub->firstline];
 
+    ++rendercounters[RC_SUBSECTORS];
+
     frontsector = sub->sector;
 
     // [AM] Interpolate sector movement. Usually only needed
@@ -698,6 +700,8 @@ void R_RenderBSPNode(int bspnum)
         // Decide which side the view point is on.
         int             side = R_PointOnSide(viewx, viewy, bsp);
 
+        ++rendercounters[RC_NODES];
+
         // Recursively divide front space.
         R_RenderBSPNode(bsp->children[side]);
 
@@ -36,10 +36,13 @@
 ========================================================================
 */
 
+#include <ctype.h>
+
 #include "c_console.h"
 #include "doomstat.h"
 #include "i_swap.h"
 #include "i_system.h"
+#include "m_cache.h"
 #include "m_misc.h"
 #include "p_local.h"
 #include "p_tick.h"
@@ -78,6 +81,16 @@ byte            **texturefullbright;
 int             *flattranslation;
 int             *texturetranslation;
 
+// flat name index
+typedef struct
+{
+    uint64_t    key;
+    int         flat;
+} flathash_t;
+
+static flathash_t   *flathash;
+static unsigned int flathashmask;
+
 // needed for prerendering
 fixed_t         *spritewidth;
 fixed_t         *spriteheight;
@@ -303,6 +316,7 @@ void R_InitTextures(void)
 
         texture = textures[i] = Z_Malloc(sizeof(texture_t) + sizeof(texpatch_t)
             * (SHORT(mtexture->patchcount) - 1), PU_STATIC, 0);
+        Z_ChangeOwner(texture, ZO_TEXTURE);
 
         texture->width = SHORT(mtexture->width);
         texture->height = SHORT(mtexture->height);
@@ -379,6 +393,65 @@ void R_InitTextures(void)
     }
 }
 
+//
+// R_FlatNameKey
+// Pack up to 8 characters of a flat name, uppercased, into a single key.
+//
+static uint64_t R_FlatNameKey(const char *name)
+{
+    uint64_t    key = 0;
+    int         i;
+
+    for (i = 0; i < 8 && name[i]; i++)
+        key |= (uint64_t)toupper((unsigned char)name[i]) << (i * 8);
+
+    return key;
+}
+
+static unsigned int R_FlatHashSlot(uint64_t key)
+{
+    return (unsigned int)((key * 0x9E3779B97F4A7C15ull) >> 32) & flathashmask;
+}
+
+//
+// R_InitFlatHash
+// Flats are looked up by name for every sector when a map is loaded, so
+// index them in an open-addressed table rather than search F_START..F_END
+// each time. The first of any duplicate names is kept, as before.
+//
+static void R_InitFlatHash(void)
+{
+    unsigned int    size = 1;
+    int             i;
+
+    while (size < (unsigned int)numflats * 2)
+        size <<= 1;
+
+    if (flathash)
+        Z_Free(flathash);
+
+    flathash = Z_Malloc(size * sizeof(*flathash), PU_STATIC, NULL);
+    flathashmask = size - 1;
+
+    for (i = 0; i < (int)size; i++)
+        flathash[i].flat = -1;
+
+    for (i = 0; i < numflats; i++)
+    {
+        uint64_t        key = R_FlatNameKey(lumpinfo[firstflat + i]->name);
+        unsigned int    slot = R_FlatHashSlot(key);
+
+        while (flathash[slot].flat != -1 && flathash[slot].key != key)
+            slot = (slot + 1) & flathashmask;
+
+        if (flathash[slot].flat == -1)
+        {
+            flathash[slot].key = key;
+            flathash[slot].flat = i;
+        }
+    }
+}
+
 //
 // R_InitFlats
 //
@@ -395,6 +468,8 @@ void R_InitFlats(void)
 
     for (i = 0; i < numflats; i++)
         flattranslation[i] = i;
+
+    R_InitFlatHash();
 }
 
 //
@@ -405,50 +480,63 @@ void R_InitFlats(void)
 //
 void R_InitSpriteLumps(void)
 {
-    int i;
+    int         i;
+    fixed_t     *spritelumps;
+    char        *cachename = (r_fixspriteoffsets ? "SPRLUMP1" : "SPRLUMP0");
 
     firstspritelump = W_GetNumForName("S_START") + 1;
     lastspritelump = W_GetNumForName("S_END") - 1;
 
     numspritelumps = lastspritelump - firstspritelump + 1;
-    spritewidth = Z_Malloc(numspritelumps * sizeof(*spritewidth), PU_STATIC, NULL);
-    spriteheight = Z_Malloc(numspritelumps * sizeof(*spriteheight), PU_STATIC, NULL);
-    spriteoffset = Z_Malloc(numspritelumps * sizeof(*spriteoffset), PU_STATIC, NULL);
-    spritetopoffset = Z_Malloc(numspritelumps * sizeof(*spritetopoffset), PU_STATIC, NULL);
 
-    newspriteoffset = Z_Malloc(numspritelumps * sizeof(*newspriteoffset), PU_STATIC, NULL);
-    newspritetopoffset = Z_Malloc(numspritelumps * sizeof(*newspritetopoffset), PU_STATIC, NULL);
+    // All six tables are kept in one block so they can be read from and written to
+    // the startup cache together, rather than reading the header of every sprite.
+    spritelumps = Z_Malloc(numspritelumps * 6 * sizeof(*spritelumps), PU_STATIC, NULL);
+    spritewidth = spritelumps;
+    spriteheight = spritewidth + numspritelumps;
+    spriteoffset = spriteheight + numspritelumps;
+    spritetopoffset = spriteoffset + numspritelumps;
+
+    newspriteoffset = spritetopoffset + numspritelumps;
+    newspritetopoffset = newspriteoffset + numspritelumps;
 
-    for (i = 0; i < numspritelumps; i++)
+    if (!M_ReadStartupCache(cachename, spritelumps, numspritelumps * 6 * sizeof(*spritelumps)))
     {
-        patch_t *patch = W_CacheLumpNum(firstspritelump + i, PU_CACHE);
+        memset(spritelumps, 0, numspritelumps * 6 * sizeof(*spritelumps));
 
-        if (patch)
+        for (i = 0; i < numspritelumps; i++)
         {
-            spritewidth[i] = SHORT(patch->width) << FRACBITS;
-            spriteheight[i] = SHORT(patch->height) << FRACBITS;
-            spriteoffset[i] = newspriteoffset[i] = SHORT(patch->leftoffset) << FRACBITS;
-            spritetopoffset[i] = newspritetopoffset[i] = SHORT(patch->topoffset) << FRACBITS;
+            patch_t *patch = W_CacheLumpNum(firstspritelump + i, PU_CACHE);
 
-            // [BH] override sprite offsets in WAD with those in sproffsets[] in info.c
-            if (r_fixspriteoffsets && !FREEDOOM && !hacx)
+            if (patch)
             {
-                int j = 0;
+                spritewidth[i] = SHORT(patch->width) << FRACBITS;
+                spriteheight[i] = SHORT(patch->height) << FRACBITS;
+                spriteoffset[i] = newspriteoffset[i] = SHORT(patch->leftoffset) << FRACBITS;
+                spritetopoffset[i] = newspritetopoffset[i] = SHORT(patch->topoffset) << FRACBITS;
 
-                while (*sproffsets[j].name)
+                // [BH] override sprite offsets in WAD with those in sproffsets[] in info.c
+                if (r_fixspriteoffsets && !FREEDOOM && !hacx)
                 {
-                    if (i == W_CheckNumForName(sproffsets[j].name) - firstspritelump
-                        && spritewidth[i] == (SHORT(sproffsets[j].width) << FRACBITS)
-                        && spriteheight[i] == (SHORT(sproffsets[j].height) << FRACBITS))
+                    int j = 0;
+
+                    while (*sproffsets[j].name)
                     {
-                        newspriteoffset[i] = SHORT(sproffsets[j].x) << FRACBITS;
-                        newspritetopoffset[i] = SHORT(sproffsets[j].y) << FRACBITS;
-                        break;
+                        if (i == W_CheckNumForName(sproffsets[j].name) - firstspritelump
+                            && spritewidth[i] == (SHORT(sproffsets[j].width) << FRACBITS)
+                            && spriteheight[i] == (SHORT(sproffsets[j].height) << FRACBITS))
+                        {
+                            newspriteoffset[i] = SHORT(sproffsets[j].x) << FRACBITS;
+                            newspritetopoffset[i] = SHORT(sproffsets[j].y) << FRACBITS;
+                            break;
+                        }
+                        j++;
                     }
-                    j++;
                 }
             }
         }
+
+        M_WriteStartupCache(cachename, spritelumps, numspritelumps * 6 * sizeof(*spritelumps));
     }
 
     if (FREEDOOM)
@@ -587,16 +675,14 @@ void R_InitData(void)
 //
 int R_FlatNumForName(char *name)
 {
-    int  i;
-
-    i = W_RangeCheckNumForName(firstflat, lastflat, name);
+    int i = R_CheckFlatNumForName(name);
 
     if (i == -1)
     {
         C_Warning("The %.8s flat can't be found.", uppercase(name));
         return skyflatnum;
     }
-    return (i - firstflat);
+    return i;
 }
 
 //
@@ -605,11 +691,16 @@ int R_FlatNumForName(char *name)
 //
 int R_CheckFlatNumForName(char *name)
 {
-    int i;
+    uint64_t        key = R_FlatNameKey(name);
+    unsigned int    slot = R_FlatHashSlot(key);
 
-    for (i = firstflat; i <= lastflat; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            return (i - firstflat);
+    while (flathash[slot].flat != -1)
+    {
+        if (flathash[slot].key == key)
+            return flathash[slot].flat;
+
+        slot = (slot + 1) & flathashmask;
+    }
 
     return -1;
 }
@@ -89,7 +89,7 @@ typedef struct
 // The SECTORS record, at runtime.
 // Stores things/mobjs.
 //
-typedef struct
+typedef struct sector_s
 {
     fixed_t             floorheight;
     fixed_t             ceilingheight;
@@ -118,6 +118,9 @@ typedef struct
     // list of mobjs in sector
     mobj_t              *thinglist;
 
+    // list of blood splats in sector
+    struct bloodsplat_s *splatlist;
+
     // thinker_t for reversible actions
     void                *floordata;             // jff 2/22/98 make thinkers on
     void                *ceilingdata;           // floors, ceilings, lighting,
@@ -37,6 +37,7 @@
 */
 
 #include "c_console.h"
+#include "m_random.h"
 #include "r_local.h"
 #include "st_stuff.h"
 #include "v_video.h"
@@ -217,7 +218,7 @@ void R_DrawFuzzyShadowColumn(void)
 
     if (--count)
     {
-        if (!(rand() % 4) && !consoleactive)
+        if (!(M_FXRandom() % 4) && !consoleactive)
             *dest = tinttab25[*dest];
         dest += SCREENWIDTH;
     }
@@ -226,7 +227,7 @@ void R_DrawFuzzyShadowColumn(void)
         *dest = tinttab25[*dest];
         dest += SCREENWIDTH;
     }
-    if (!(rand() % 4) && !consoleactive)
+    if (!(M_FXRandom() % 4) && !consoleactive)
         *dest = tinttab25[*dest];
 }
 
@@ -1025,7 +1026,7 @@ extern int      fuzzpos;
 
 int             fuzzrange[3] = { -SCREENWIDTH, 0, SCREENWIDTH };
 
-#define FUZZ(a, b)      fuzzrange[rand() % (b - a + 1) + a]
+#define FUZZ(a, b)      fuzzrange[M_FXRandom() % (b - a + 1) + a]
 #define NOFUZZ          251
 
 void R_DrawFuzzColumn(void)
@@ -1043,7 +1044,7 @@ void R_DrawFuzzColumn(void)
         // top
         if (!dc_yl)
             *dest = fullcolormap[6 * 256 + dest[(fuzztable[fuzzpos++] = FUZZ(1, 2))]];
-        else if (!(rand() % 4))
+        else if (!(M_FXRandom() % 4))
             *dest = fullcolormap[12 * 256 + dest[(fuzztable[fuzzpos++] = FUZZ(0, 2))]];
         dest += SCREENWIDTH;
 
@@ -1057,7 +1058,7 @@ void R_DrawFuzzColumn(void)
         // bottom
         if (dc_yh == viewheight - 1)
             *dest = fullcolormap[5 * 256 + dest[(fuzztable[fuzzpos] = FUZZ(0, 1))]];
-        else if (dc_baseclip == -1 && !(rand() % 4))
+        else if (dc_baseclip == -1 && !(M_FXRandom() % 4))
             *dest = fullcolormap[14 * 256 + dest[(fuzztable[fuzzpos] = FUZZ(0, 1))]];
     }
 }
@@ -1117,7 +1118,7 @@ void R_DrawFuzzColumns(void)
                 if (!y || *(src - SCREENWIDTH) == NOFUZZ)
                 {
                     // top
-                    if (!(rand() % 4))
+                    if (!(M_FXRandom() % 4))
                         *dest = fullcolormap[12 * 256 + dest[(fuzztable[i] = FUZZ(0, 2))]];
                 }
                 else if (y == h - SCREENWIDTH)
@@ -1128,7 +1129,7 @@ void R_DrawFuzzColumns(void)
                 else if (*(src + SCREENWIDTH) == NOFUZZ)
                 {
                     // bottom of post
-                    if (!(rand() % 4))
+                    if (!(M_FXRandom() % 4))
                         *dest = fullcolormap[12 * 256 + dest[(fuzztable[i] = FUZZ(0, 2))]];
                 }
                 else
@@ -1136,7 +1137,7 @@ void R_DrawFuzzColumns(void)
                     // middle
                     if (*(src - 1) == NOFUZZ || *(src + 1) == NOFUZZ)
                     {
-                        if (!(rand() % 4))
+                        if (!(M_FXRandom() % 4))
                             *dest = fullcolormap[12 * 256 + dest[(fuzztable[i] = FUZZ(0, 2))]];
                     }
                     else
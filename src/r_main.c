@@ -36,9 +36,13 @@
 ========================================================================
 */
 
+#include <string.h>
+
 #include "c_console.h"
 #include "doomstat.h"
+#include "g_game.h"
 #include "i_timer.h"
+#include "m_profile.h"
 #include "p_local.h"
 #include "r_sky.h"
 #include "v_video.h"
@@ -113,8 +117,33 @@ dboolean                r_translucency = r_translucency_default;
 
 dboolean                r_homindicator = r_homindicator_default;
 
+dboolean                r_showrenderstats = r_showrenderstats_default;
+
 int                     r_frame_count;
 
+// renderer workload of the frame being drawn, the last frame drawn, and the
+// maximum and total since the counters were last reset
+int                     rendercounters[NUMRENDERCOUNTERS];
+int                     rendercounterslast[NUMRENDERCOUNTERS];
+int                     rendercountersmax[NUMRENDERCOUNTERS];
+uint64_t                rendercounterstotal[NUMRENDERCOUNTERS];
+unsigned int            rendercountersframes;
+
+char *rendercounternames[NUMRENDERCOUNTERS] =
+{
+    "Visplanes",
+    "Drawsegs",
+    "Vissprites",
+    "Blood splat vissprites",
+    "Shadow vissprites",
+    "Openings",
+    "BSP nodes",
+    "Subsectors",
+    "Wall columns",
+    "Span pixels",
+    "Masked columns"
+};
+
 extern int              viewheight2;
 
 void (*colfunc)(void);
@@ -657,7 +686,7 @@ void R_SetupFrame(player_t *player)
 
     // Figure out how far into the current tic we're in as a fixed_t
     if (!vid_capfps)
-        fractionaltic = I_GetTimeMS() * TICRATE % 1000 * FRACUNIT / 1000;
+        fractionaltic = I_GetTimeFrac();
 
     if (!vid_capfps
         // Don't interpolate on the first tic of a level, otherwise
@@ -673,7 +702,19 @@ void R_SetupFrame(player_t *player)
         viewx = mo->oldx + FixedMul(mo->x - mo->oldx, fractionaltic);
         viewy = mo->oldy + FixedMul(mo->y - mo->oldy, fractionaltic);
         viewz = player->oldviewz + FixedMul(player->viewz - player->oldviewz, fractionaltic);
-        viewangle = R_InterpolateAngle(mo->oldangle, mo->angle, fractionaltic);
+
+        // Show mouse movement as soon as it happens, instead of when the next
+        // tic is run. Only the rest of the last tic's turn is interpolated.
+        if (m_latelatch && player->playerstate == PST_LIVE && !mo->reactiontime)
+        {
+            angle_t     lastturn = G_GetLastMouseTurn();
+
+            viewangle = R_InterpolateAngle(mo->oldangle, mo->angle - lastturn, fractionaltic)
+                + lastturn + G_GetLatchedTurn();
+            I_MouseShown();
+        }
+        else
+            viewangle = R_InterpolateAngle(mo->oldangle, mo->angle, fractionaltic);
     }
     else
     {
@@ -724,12 +765,42 @@ void R_SetupFrame(player_t *player)
     ++validcount;
 }
 
+//
+// R_ResetRenderCounters
+//
+void R_ResetRenderCounters(void)
+{
+    memset(rendercounterslast, 0, sizeof(rendercounterslast));
+    memset(rendercountersmax, 0, sizeof(rendercountersmax));
+    memset(rendercounterstotal, 0, sizeof(rendercounterstotal));
+    rendercountersframes = 0;
+}
+
+static void R_UpdateRenderCounters(void)
+{
+    int i;
+
+    rendercounters[RC_OPENINGS] = lastopening - openings;
+
+    for (i = 0; i < NUMRENDERCOUNTERS; ++i)
+    {
+        rendercounterslast[i] = rendercounters[i];
+        rendercountersmax[i] = MAX(rendercountersmax[i], rendercounters[i]);
+        rendercounterstotal[i] += rendercounters[i];
+    }
+
+    ++rendercountersframes;
+}
+
 //
 // R_RenderPlayerView
 //
 void R_RenderPlayerView(player_t *player)
 {
+    PROFILE_BEGIN(PROF_R_RENDERPLAYERVIEW);
+
     ++r_frame_count;
+    memset(rendercounters, 0, sizeof(rendercounters));
 
     R_SetupFrame(player);
 
@@ -741,7 +812,10 @@ void R_RenderPlayerView(player_t *player)
 
     if (automapactive)
     {
+        PROFILE_BEGIN(PROF_R_RENDERBSPNODE);
         R_RenderBSPNode(numnodes - 1);
+        PROFILE_END(PROF_R_RENDERBSPNODE);
+
         if (r_playersprites)
             R_DrawPlayerSprites();
     }
@@ -754,9 +828,20 @@ void R_RenderPlayerView(player_t *player)
                 ((gametic % 20) < 9 && !consoleactive && !menuactive && !paused ? 176 : 0));
 
         // The head node is the last node output.
+        PROFILE_BEGIN(PROF_R_RENDERBSPNODE);
         R_RenderBSPNode(numnodes - 1);
+        PROFILE_END(PROF_R_RENDERBSPNODE);
 
+        PROFILE_BEGIN(PROF_R_DRAWPLANES);
         R_DrawPlanes();
+        PROFILE_END(PROF_R_DRAWPLANES);
+
+        PROFILE_BEGIN(PROF_R_DRAWMASKED);
         R_DrawMasked();
+        PROFILE_END(PROF_R_DRAWMASKED);
     }
+
+    R_UpdateRenderCounters();
+
+    PROFILE_END(PROF_R_RENDERPLAYERVIEW);
 }
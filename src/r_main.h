@@ -152,6 +152,37 @@ subsector_t *R_PointInSubsector(fixed_t x, fixed_t y);
 // [AM] Interpolate between two angles.
 angle_t R_InterpolateAngle(angle_t oangle, angle_t nangle, fixed_t scale);
 
+//
+// Per-frame renderer workload counters.
+//
+typedef enum
+{
+    RC_VISPLANES,
+    RC_DRAWSEGS,
+    RC_VISSPRITES,
+    RC_BLOODSPLATVISSPRITES,
+    RC_SHADOWVISSPRITES,
+    RC_OPENINGS,
+    RC_NODES,
+    RC_SUBSECTORS,
+    RC_WALLCOLUMNS,
+    RC_SPANPIXELS,
+    RC_MASKEDCOLUMNS,
+    NUMRENDERCOUNTERS
+} rendercounter_t;
+
+extern int              rendercounters[NUMRENDERCOUNTERS];
+extern int              rendercounterslast[NUMRENDERCOUNTERS];
+extern int              rendercountersmax[NUMRENDERCOUNTERS];
+extern uint64_t         rendercounterstotal[NUMRENDERCOUNTERS];
+extern unsigned int     rendercountersframes;
+
+extern char             *rendercounternames[NUMRENDERCOUNTERS];
+
+extern dboolean         r_showrenderstats;
+
+void R_ResetRenderCounters(void);
+
 //
 // REFRESH - the actual rendering functions.
 //
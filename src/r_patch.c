@@ -260,6 +260,7 @@ static void createPatch(int id)
     // allocate our data chunk
     dataSize = pixelDataSize + columnsDataSize + postsDataSize;
     patch->data = (unsigned char *)Z_Malloc(dataSize, PU_CACHE, (void **)&patch->data);
+    Z_ChangeOwner(patch->data, ZO_PATCH);
     memset(patch->data, 0, dataSize);
 
     // set out pixel, column, and post pointers into our data array
@@ -403,6 +404,118 @@ static void removePostFromColumn(rcolumn_t *column, int post)
     column->numPosts--;
 }
 
+static unsigned int hashColumn(const rcolumn_t *column, int height)
+{
+    unsigned int        hash = 5381;
+    int                 i;
+
+    for (i = 0; i < height; ++i)
+        hash = ((hash << 5) + hash) + column->pixels[i];
+
+    for (i = 0; i < column->numPosts; ++i)
+        hash = ((hash << 5) + hash) + (column->posts[i].topdelta << 16) + column->posts[i].length;
+
+    return hash;
+}
+
+static dboolean sameColumn(const rcolumn_t *column1, const rcolumn_t *column2, int height)
+{
+    return (column1->numPosts == column2->numPosts
+        && !memcmp(column1->pixels, column2->pixels, height)
+        && !memcmp(column1->posts, column2->posts, column1->numPosts * sizeof(rpost_t)));
+}
+
+//
+// Textures are often built from the same patch repeated across their width,
+// so once a composite has been built, only one copy of each column is kept in
+// the zone and any identical columns share it. Every column still has all of
+// its pixels, as solid walls draw the whole of them.
+//
+static void storeCompositePatch(rpatch_t *patch)
+{
+    unsigned char       *olddata = patch->data;
+    rcolumn_t           *oldcolumns = patch->columns;
+    int                 width = patch->width;
+    int                 height = patch->height;
+    int                 hashsize = 1;
+    int                 *hashtable;
+    int                 *sharedwith = malloc(width * sizeof(int));
+    int                 numUniqueColumns = 0;
+    int                 numPostsTotal = 0;
+    int                 pixelDataSize;
+    int                 columnsDataSize;
+    int                 dataSize;
+    unsigned char       *pixels;
+    rpost_t             *posts;
+    int                 x;
+
+    while (hashsize < width * 2)
+        hashsize <<= 1;
+
+    hashtable = malloc(hashsize * sizeof(int));
+    memset(hashtable, -1, hashsize * sizeof(int));
+
+    // find the first of any identical columns
+    for (x = 0; x < width; ++x)
+    {
+        int     slot = hashColumn(&oldcolumns[x], height) & (hashsize - 1);
+
+        sharedwith[x] = x;
+
+        while (hashtable[slot] >= 0)
+        {
+            if (sameColumn(&oldcolumns[hashtable[slot]], &oldcolumns[x], height))
+            {
+                sharedwith[x] = hashtable[slot];
+                break;
+            }
+            slot = (slot + 1) & (hashsize - 1);
+        }
+
+        if (sharedwith[x] == x)
+        {
+            hashtable[slot] = x;
+            numUniqueColumns++;
+            numPostsTotal += oldcolumns[x].numPosts;
+        }
+    }
+
+    pixelDataSize = (numUniqueColumns * height + 3) & ~3;
+    columnsDataSize = sizeof(rcolumn_t) * width;
+    dataSize = pixelDataSize + columnsDataSize + numPostsTotal * sizeof(rpost_t);
+
+    patch->data = (unsigned char *)Z_Malloc(dataSize, PU_STATIC, (void **)&patch->data);
+    Z_ChangeOwner(patch->data, ZO_TEXTURE);
+
+    patch->pixels = pixels = patch->data;
+    patch->columns = (rcolumn_t *)(patch->data + pixelDataSize);
+    patch->posts = posts = (rpost_t *)((unsigned char *)patch->columns + columnsDataSize);
+
+    for (x = 0; x < width; ++x)
+    {
+        rcolumn_t       *column = &patch->columns[x];
+        rcolumn_t       *oldcolumn = &oldcolumns[x];
+
+        if (sharedwith[x] != x)
+        {
+            *column = patch->columns[sharedwith[x]];
+            continue;
+        }
+
+        column->pixels = pixels;
+        column->numPosts = oldcolumn->numPosts;
+        column->posts = posts;
+        memcpy(pixels, oldcolumn->pixels, height);
+        memcpy(posts, oldcolumn->posts, oldcolumn->numPosts * sizeof(rpost_t));
+        pixels += height;
+        posts += oldcolumn->numPosts;
+    }
+
+    free(hashtable);
+    free(sharedwith);
+    free(olddata);
+}
+
 static void createTextureCompositePatch(int id)
 {
     rpatch_t            *composite_patch = &texture_composites[id];
@@ -468,11 +581,9 @@ static void createTextureCompositePatch(int id)
 
     postsDataSize = numPostsTotal * sizeof(rpost_t);
 
-    // allocate our data chunk
+    // allocate our data chunk, which is only used while the texture is being built
     dataSize = pixelDataSize + columnsDataSize + postsDataSize;
-    composite_patch->data = (unsigned char *)Z_Malloc(dataSize, PU_STATIC,
-        (void **)&composite_patch->data);
-    memset(composite_patch->data, 0, dataSize);
+    composite_patch->data = (unsigned char *)calloc(1, dataSize);
 
     // set out pixel, column, and post pointers into our data array
     composite_patch->pixels = composite_patch->data;
@@ -686,6 +797,7 @@ static void createTextureCompositePatch(int id)
     }
 
     free(countsInColumn);
+    storeCompositePatch(composite_patch);
 }
 
 rpatch_t *R_CacheTextureCompositePatchNum(int id)
@@ -694,7 +806,12 @@ rpatch_t *R_CacheTextureCompositePatchNum(int id)
         I_Error("R_CacheTextureCompositePatchNum: Composite patches not initialized");
 
     if (!texture_composites[id].data)
+    {
         createTextureCompositePatch(id);
+        ++zonecachemisses;
+    }
+    else
+        ++zonecachehits;
 
     // cph - if wasn't locked but now is, tell z_zone to hold it
     if (!texture_composites[id].locks)
@@ -118,6 +118,8 @@ static void R_MapPlane(int y, int x1, int x2)
     ds_x1 = x1;
     ds_x2 = x2;
 
+    rendercounters[RC_SPANPIXELS] += x2 - x1 + 1;
+
     spanfunc();
 }
 
@@ -154,6 +156,7 @@ static visplane_t *new_visplane(unsigned hash)
         freehead = &freetail;
     check->next = visplanes[hash];
     visplanes[hash] = check;
+    ++rendercounters[RC_VISPLANES];
     return check;
 }
 
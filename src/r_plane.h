@@ -43,6 +43,7 @@
 #define PL_SKYFLAT      0x80000000
 
 // Visplane related.
+extern  int     *openings;
 extern  int     *lastopening;
 
 extern int      floorclip[];
@@ -316,6 +316,7 @@ void R_RenderMaskedSegRange(drawseg_t *ds, int x1, int x2)
 
             // draw the texture
             R_DrawMaskedColumn(patch, R_GetPatchColumnWrapped(patch, maskedtexturecol[dc_x]));
+            ++rendercounters[RC_MASKEDCOLUMNS];
             maskedtexturecol[dc_x] = INT_MAX;   // dropoff overflow
         }
     }
@@ -425,6 +426,8 @@ void R_RenderSegLoop(void)
                 else
                     wallcolfunc();
 
+                ++rendercounters[RC_WALLCOLUMNS];
+
                 R_UnlockTextureCompositePatchNum(midtexture);
                 tex_patch = NULL;
             }
@@ -474,6 +477,8 @@ void R_RenderSegLoop(void)
                         else
                             wallcolfunc();
 
+                        ++rendercounters[RC_WALLCOLUMNS];
+
                         R_UnlockTextureCompositePatchNum(toptexture);
                         tex_patch = NULL;
                     }
@@ -529,6 +534,8 @@ void R_RenderSegLoop(void)
                         else
                             wallcolfunc();
 
+                        ++rendercounters[RC_WALLCOLUMNS];
+
                         R_UnlockTextureCompositePatchNum(bottomtexture);
                         tex_patch = NULL;
                     }
@@ -1007,4 +1014,5 @@ void R_StoreWallRange(int start, int stop)
         ds_p->bsilheight = INT_MAX;
     }
     ++ds_p;
+    ++rendercounters[RC_DRAWSEGS];
 }
@@ -353,6 +353,8 @@ static vissprite_t *R_NewVisSprite(fixed_t scale)
     vissprite_t         *rc;
     vissprite_t         *vis;
 
+    ++rendercounters[RC_VISSPRITES];
+
     switch (num_vissprite)
     {
         case 0:
@@ -569,6 +571,8 @@ void R_DrawVisSprite(vissprite_t *vis)
 
     fuzzpos = 0;
 
+    rendercounters[RC_MASKEDCOLUMNS] += x2 - vis->x1 + 1;
+
     for (dc_x = vis->x1; dc_x <= x2; dc_x++, frac += xiscale)
         R_DrawMaskedSpriteColumn((column_t *)((byte *)patch
             + LONG(patch->columnofs[frac >> FRACBITS])));
@@ -598,6 +602,8 @@ void R_DrawPVisSprite(vissprite_t *vis)
     dc_baseclip = -1;
     fuzzpos = 0;
 
+    rendercounters[RC_MASKEDCOLUMNS] += x2 - vis->x1 + 1;
+
     for (dc_x = vis->x1; dc_x <= x2; dc_x++, frac += xiscale)
         R_DrawMaskedSpriteColumn((column_t *)((byte *)patch
             + LONG(patch->columnofs[frac >> FRACBITS])));
@@ -621,6 +627,8 @@ void R_DrawBloodSplatVisSprite(vissprite_t *vis)
 
     fuzzpos = 0;
 
+    rendercounters[RC_MASKEDCOLUMNS] += x2 - vis->x1 + 1;
+
     for (dc_x = vis->x1; dc_x <= x2; dc_x++, frac += xiscale)
         R_DrawMaskedBloodSplatColumn((column_t *)((byte *)patch
             + LONG(patch->columnofs[frac >> FRACBITS])));
@@ -641,6 +649,8 @@ void R_DrawShadowVisSprite(vissprite_t *vis)
     sprtopscreen = centeryfrac - FixedMul(vis->texturemid, spryscale);
     shift = (sprtopscreen * 9 / 10) >> FRACBITS;
 
+    rendercounters[RC_MASKEDCOLUMNS] += x2 - vis->x1 + 1;
+
     for (dc_x = vis->x1; dc_x <= x2; dc_x++, frac += xiscale)
         R_DrawMaskedShadowColumn((column_t *)((byte *)patch
             + LONG(patch->columnofs[frac >> FRACBITS])));
@@ -877,7 +887,7 @@ void R_ProjectSprite(mobj_t *thing)
         vis->colormap = spritelights[BETWEEN(0, xscale >> LIGHTSCALESHIFT, MAXLIGHTSCALE - 1)];
 }
 
-void R_ProjectBloodSplat(mobj_t *thing)
+void R_ProjectBloodSplat(bloodsplat_t *splat)
 {
     fixed_t             tx;
 
@@ -890,8 +900,8 @@ void R_ProjectBloodSplat(mobj_t *thing)
 
     vissprite_t         *vis;
 
-    fixed_t             fx = thing->x;
-    fixed_t             fy = thing->y;
+    fixed_t             fx = splat->x;
+    fixed_t             fy = splat->y;
     fixed_t             fz;
 
     fixed_t             width;
@@ -918,7 +928,7 @@ void R_ProjectBloodSplat(mobj_t *thing)
         return;
 
     // decide which patch to use for sprite relative to player
-    lump = sprites[SPR_BLD2].spriteframes[thing->frame].lump[0];
+    lump = sprites[SPR_BLD2].spriteframes[splat->frame].lump[0];
     width = spritewidth[lump];
 
     // calculate edges of the shape
@@ -937,20 +947,21 @@ void R_ProjectBloodSplat(mobj_t *thing)
 
     // store information in a vissprite
     vis = &bloodvissprites[num_bloodvissprite++];
+    ++rendercounters[RC_BLOODSPLATVISSPRITES];
 
     vis->type = MT_BLOODSPLAT;
     vis->scale = xscale;
     vis->gx = fx;
     vis->gy = fy;
-    fz = thing->subsector->sector->interpfloorheight;
+    fz = splat->sector->interpfloorheight;
     vis->gz = fz;
     vis->gzt = fz + 1;
-    vis->blood = thing->blood;
+    vis->blood = splat->blood;
 
-    if ((thing->flags & MF_FUZZ) && (menuactive || paused || consoleactive))
-        vis->colfunc = R_DrawPausedFuzzColumn;
+    if (splat->flags & BSF_FUZZ)
+        vis->colfunc = (menuactive || paused || consoleactive ? R_DrawPausedFuzzColumn : fuzzcolfunc);
     else
-        vis->colfunc = thing->colfunc;
+        vis->colfunc = bloodsplatcolfunc;
 
     vis->texturemid = fz + 1 - viewz;
 
@@ -1054,6 +1065,7 @@ void R_ProjectShadow(mobj_t *thing)
 
     // store information in a vissprite
     vis = &shadowvissprites[num_shadowvissprite++];
+    ++rendercounters[RC_SHADOWVISSPRITES];
 
     vis->mobjflags = 0;
     vis->mobjflags2 = 0;
@@ -1092,12 +1104,16 @@ void R_ProjectShadow(mobj_t *thing)
 // killough 9/18/98: add lightlevel as parameter, fixing underwater lighting
 void R_AddSprites(sector_t *sec, int lightlevel)
 {
-    mobj_t      *thing;
-    short       floorpic = sec->floorpic;
+    mobj_t          *thing;
+    bloodsplat_t    *splat;
+    short           floorpic = sec->floorpic;
 
     spritelights = scalelight[BETWEEN(0, (lightlevel >> LIGHTSEGSHIFT) + extralight * LIGHTBRIGHT,
         LIGHTLEVELS - 1)];
 
+    for (splat = sec->splatlist; splat; splat = splat->snext)
+        R_ProjectBloodSplat(splat);
+
     // Handle all things in sector.
     if (fixedcolormap || isliquid[floorpic] || floorpic == skyflatnum || !r_shadows)
         for (thing = sec->thinglist; thing; thing = thing->snext)
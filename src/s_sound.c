@@ -130,11 +130,15 @@ dboolean                s_randompitch = s_randompitch_default;
 dboolean                nosfx = false;
 dboolean                nomusic = false;
 
+// Whether S_OpenAudio managed to open the device
+static dboolean         sfxopened;
+static dboolean         musicopened;
+
 // Find and initialize a sound_module_t appropriate for the setting
 // in snd_sfxdevice.
 static void InitSfxModule(void)
 {
-    if (I_InitSound())
+    if (sfxopened)
     {
         C_Output("Sound effects playing at a sample rate of %.1fkHz on %i channels.",
             SAMPLERATE / 1000.0f, numChannels);
@@ -148,7 +152,7 @@ static void InitSfxModule(void)
 // Initialize music according to snd_musicdevice.
 static void InitMusicModule(void)
 {
-    if (I_InitMusic())
+    if (musicopened)
     {
         C_Output("Using General MIDI for music.");
 
@@ -161,11 +165,9 @@ static void InitMusicModule(void)
 }
 
 //
-// Initializes sound stuff, including volume
-// Sets channels, SFX and music volume,
-//  allocates channel buffer, sets S_sfx lookup.
+// S_CheckParms
 //
-void S_Init(int sfxvol, int musicvol)
+void S_CheckParms(void)
 {
     if (M_CheckParm("-nosound") > 0)
     {
@@ -187,12 +189,39 @@ void S_Init(int sfxvol, int musicvol)
         nosfx = true;
     }
 
+    if (!nosfx)
+        I_CheckSoundVersion();
+
     // This is kind of a hack. If native MIDI is enabled, set up
     // the TIMIDITY_CFG environment variable here before SDL_mixer
     // is opened.
     if (!nomusic)
         I_InitTimidityConfig();
+}
+
+//
+// S_OpenAudio
+//
+// Opening the audio device can take a while, and only touches SDL and
+// SDL_mixer, so it is run alongside the rest of startup. The results are
+// reported by S_Init.
+//
+void S_OpenAudio(void)
+{
+    if (!nosfx)
+        sfxopened = I_InitSound();
+
+    if (!nomusic)
+        musicopened = I_InitMusic();
+}
 
+//
+// Initializes sound stuff, including volume
+// Sets channels, SFX and music volume,
+//  allocates channel buffer, sets S_sfx lookup.
+//
+void S_Init(int sfxvol, int musicvol)
+{
     if (!nosfx)
     {
         int i;
@@ -648,6 +677,8 @@ void S_ChangeMusic(int music_id, dboolean looping, dboolean cheating, dboolean m
     {
         // Load & register it
         music->data = W_CacheLumpNum(music->lumpnum, PU_STATIC);
+        if (!W_IsMappedLump(music->lumpnum))
+            Z_ChangeOwner(music->data, ZO_SOUND);
         handle = I_RegisterSong(music->data, W_LumpLength(music->lumpnum));
     }
 
@@ -702,7 +733,9 @@ void S_ChangeMusInfoMusic(int lumpnum, int looping)
     music->lumpnum = lumpnum;
 
     // load & register it
-    music->data = W_CacheLumpNum(music->lumpnum, PU_CACHE);
+    music->data = W_CacheLumpNum(music->lumpnum, PU_STATIC);
+    if (!W_IsMappedLump(music->lumpnum))
+        Z_ChangeOwner(music->data, ZO_SOUND);
     music->handle = I_RegisterSong(music->data, W_LumpLength(music->lumpnum));
 
     // play it
@@ -47,6 +47,7 @@
 
 extern dboolean s_randompitch;
 
+void I_CheckSoundVersion(void);
 dboolean I_InitSound(void);
 void I_ShutdownSound(void);
 int I_GetSfxLumpNum(sfxinfo_t *sfx);
@@ -67,6 +68,13 @@ void I_PlaySong(void *handle, int looping);
 void I_StopSong(void);
 dboolean I_MusicIsPlaying(void);
 
+// Checks the command-line and the version of SDL_mixer before the audio
+// device is opened.
+void S_CheckParms(void);
+
+// Opens the audio device. Safe to call from a worker thread.
+void S_OpenAudio(void);
+
 //
 // Initializes sound stuff, including volume
 // Sets channels, SFX and music volume,
@@ -66,6 +66,7 @@ void ST_Drawer(dboolean fullscreen, dboolean refresh);
 
 // Called when the console player is spawned on each level.
 void ST_Start(void);
+void ST_doPaletteStuff(void);
 
 // Called by startup code.
 void ST_Init(void);
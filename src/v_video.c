@@ -341,7 +341,7 @@ void V_DrawSpectreShadowPatch(int x, int y, patch_t *patch)
 
             if (--count)
             {
-                if (!(rand() % 4))
+                if (!(M_FXRandom() % 4))
                     *dest = tinttab25[*dest];
                 dest += SCREENWIDTH;
             }
@@ -350,7 +350,7 @@ void V_DrawSpectreShadowPatch(int x, int y, patch_t *patch)
                 *dest = tinttab25[*dest];
                 dest += SCREENWIDTH;
             }
-            if (!(rand() % 4))
+            if (!(M_FXRandom() % 4))
                 *dest = tinttab25[*dest];
 
             column = (column_t *)((byte *)column + column->length + 4);
@@ -982,7 +982,7 @@ void V_DrawFlippedSpectreShadowPatch(int x, int y, patch_t *patch)
 
             if (--count)
             {
-                if (!(rand() % 4))
+                if (!(M_FXRandom() % 4))
                     *dest = tinttab25[*dest];
                 dest += SCREENWIDTH;
             }
@@ -991,7 +991,7 @@ void V_DrawFlippedSpectreShadowPatch(int x, int y, patch_t *patch)
                 *dest = tinttab25[*dest];
                 dest += SCREENWIDTH;
             }
-            if (!(rand() % 4))
+            if (!(M_FXRandom() % 4))
                 *dest = tinttab25[*dest];
 
             column = (column_t *)((byte *)column + column->length + 4);
@@ -1035,7 +1035,7 @@ void V_DrawFlippedTranslucentRedPatch(int x, int y, patch_t *patch)
     }
 }
 
-#define _FUZZ(a, b)     _fuzzrange[M_RandomInt(a + 1, b + 1)]
+#define _FUZZ(a, b)     _fuzzrange[M_FXRandom() % (b - a + 1) + a + 1]
 
 const int       _fuzzrange[3] = { -SCREENWIDTH, 0, SCREENWIDTH };
 
@@ -42,7 +42,8 @@
 #define PACKAGE_VERSION                 2,3,0,0
 #define PACKAGE_VERSIONSTRING           "2.3"
 #define PACKAGE_NAMEANDVERSIONSTRING    "DOOM Retro v2.3"
-#define PACKAGE_SAVEGAMEVERSIONSTRING   "DOOM Retro v2.3"
+#define PACKAGE_SAVEGAMEVERSIONSTRING   "DOOM Retro v2.3.1"
+#define PACKAGE_TINTCACHEVERSIONSTRING  "DOOM Retro tint tables v1"
 
 #define PACKAGE                         "doomretro"
 #define PACKAGE_CONFIG                  "doomretro.cfg"
@@ -52,6 +53,8 @@
 #define PACKAGE_MUTEX                   "DOOMRETRO-CC4F1071-8B24-4E91-A207-D792F39636CD"
 #define PACKAGE_NAME                    "DOOM Retro"
 #define PACKAGE_SAVE                    "doomretro%i.save"
+#define PACKAGE_STARTUPCACHE            "doomretro.cache"
+#define PACKAGE_TINTCACHE               "doomretro.tints"
 #define PACKAGE_WAD                     "doomretro.wad"
 #define PACKAGE_WIKI_START_URL          "http://start.doomretro.com/"
 #define PACKAGE_WIKI_HELP_URL           "http://help.doomretro.com/"
@@ -37,11 +37,67 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "m_misc.h"
 #include "w_file.h"
 #include "z_zone.h"
 
+//
+// W_MapFile
+//
+// Maps the whole of a file copy-on-write, so lumps can be used in place
+// without reading them into the zone, and any code that changes lump data
+// only gets its own copy of the pages it writes to.
+//
+static byte *W_MapFile(FILE *fstream, unsigned int length)
+{
+#if defined(WIN32)
+    HANDLE      mapping;
+    byte        *result;
+
+    if (!length)
+        return NULL;
+
+    if (!(mapping = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(fstream)), NULL,
+        PAGE_WRITECOPY, 0, 0, NULL)))
+        return NULL;
+
+    // The view keeps its own reference to the mapping
+    result = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+
+    return result;
+#else
+    void        *result;
+
+    if (!length)
+        return NULL;
+
+    result = mmap(NULL, length, (PROT_READ | PROT_WRITE), MAP_PRIVATE, fileno(fstream), 0);
+
+    return (result == MAP_FAILED ? NULL : result);
+#endif
+}
+
+static void W_UnmapFile(byte *mapped, unsigned int length)
+{
+#if defined(WIN32)
+    UnmapViewOfFile(mapped);
+#else
+    munmap(mapped, length);
+#endif
+}
+
 wad_file_t *W_OpenFile(char *path)
 {
     wad_file_t  *result;
@@ -54,13 +110,31 @@ wad_file_t *W_OpenFile(char *path)
     result = Z_Malloc(sizeof(wad_file_t), PU_STATIC, NULL);
     result->length = M_FileLength(fstream);
     result->fstream = fstream;
+    result->mem = NULL;
+    result->mapped = W_MapFile(fstream, result->length);
+
+    return result;
+}
+
+wad_file_t *W_OpenMemory(void *data, unsigned int length)
+{
+    wad_file_t  *result = Z_Malloc(sizeof(wad_file_t), PU_STATIC, NULL);
+
+    result->length = length;
+    result->fstream = NULL;
+    result->mem = data;
+    result->mapped = NULL;
 
     return result;
 }
 
 void W_CloseFile(wad_file_t *wad)
 {
-    fclose(wad->fstream);
+    if (wad->mapped)
+        W_UnmapFile(wad->mapped, wad->length);
+    if (wad->fstream)
+        fclose(wad->fstream);
+    free(wad->mem);
     Z_Free(wad);
 }
 
@@ -68,9 +142,46 @@ void W_CloseFile(wad_file_t *wad)
 // provided buffer. Returns the number of bytes read.
 size_t W_Read(wad_file_t *wad, unsigned int offset, void *buffer, size_t buffer_len)
 {
+    byte        *data = (wad->mapped ? wad->mapped : wad->mem);
+
+    if (data)
+    {
+        if (offset >= wad->length)
+            return 0;
+
+        if (buffer_len > wad->length - offset)
+            buffer_len = wad->length - offset;
+
+        memcpy(buffer, data + offset, buffer_len);
+        return buffer_len;
+    }
+
     // Jump to the specified position in the file.
     fseek(wad->fstream, offset, SEEK_SET);
 
     // Read into the buffer.
     return fread(buffer, 1, buffer_len, wad->fstream);
 }
+
+void W_Prefetch(wad_file_t *wad, unsigned int offset, size_t length)
+{
+#if !defined(WIN32)
+    static size_t       pagesize;
+    size_t              start;
+
+    if (!wad->mapped || offset >= wad->length || !length)
+        return;
+
+    if (!pagesize)
+        pagesize = sysconf(_SC_PAGESIZE);
+
+    // madvise() needs a page-aligned address
+    start = offset & ~(pagesize - 1);
+    if (length > wad->length - offset)
+        length = wad->length - offset;
+
+    length += offset - start;
+
+    madvise(wad->mapped + start, length, MADV_WILLNEED);
+#endif
+}
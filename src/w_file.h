@@ -49,6 +49,13 @@ struct _wad_file_s
 {
     FILE                *fstream;
 
+    // Lump data for WADs built in memory, or NULL.
+    byte                *mem;
+
+    // The whole file, mapped privately so writes never reach the file, or
+    // NULL if it couldn't be mapped.
+    byte                *mapped;
+
     // Length of the file, in bytes.
     unsigned int        length;
 
@@ -63,6 +70,10 @@ struct _wad_file_s
 // handle for the WAD file, or NULL if it could not be opened.
 wad_file_t *W_OpenFile(char *path);
 
+// Wrap a block of memory holding a complete WAD. The memory must have
+// been allocated with malloc() and is freed when the WAD is closed.
+wad_file_t *W_OpenMemory(void *data, unsigned int length);
+
 // Close the specified WAD file.
 void W_CloseFile(wad_file_t *wad);
 
@@ -71,4 +82,7 @@ void W_CloseFile(wad_file_t *wad);
 // Returns the number of bytes read.
 size_t W_Read(wad_file_t *wad, unsigned int offset, void *buffer, size_t buffer_len);
 
+// Hint that the specified range of a mapped file is about to be read.
+void W_Prefetch(wad_file_t *wad, unsigned int offset, size_t length);
+
 #endif
@@ -479,7 +479,7 @@ static void DoMerge(void)
     }
 
     // Switch to the new lumpinfo, and free the old one
-    free(lumpinfo);
+    Z_Realloc(lumpinfo, 0);
     lumpinfo = newlumps;
     numlumps = num_newlumps;
 }
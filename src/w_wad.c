@@ -46,30 +46,6 @@
 #include "w_wad.h"
 #include "z_zone.h"
 
-#if defined(_MSC_VER)
-#pragma pack(push)
-#pragma pack(1)
-#endif
-
-typedef struct
-{
-    // Should be "IWAD" or "PWAD".
-    char        identification[4];
-    int         numlumps;
-    int         infotableofs;
-} PACKEDATTR wadinfo_t;
-
-typedef struct
-{
-    int         filepos;
-    int         size;
-    char        name[8];
-} PACKEDATTR filelump_t;
-
-#if defined(_MSC_VER)
-#pragma pack(pop)
-#endif
-
 //
 // GLOBALS
 //
@@ -81,6 +57,9 @@ int                     numlumps = 0;
 // Hash table for fast lookups
 static lumpindex_t      *lumphash;
 
+// Alignment a lump in a mapped WAD needs to be used in place
+#define LUMPALIGNMENT   4
+
 void ExtractFileBase(char *path, char *dest)
 {
     char        *src = path + strlen(path) - 1;
@@ -117,6 +96,54 @@ unsigned int W_LumpNameHash(const char *s)
 // LUMP BASED ROUTINES.
 //
 
+//
+// W_AddDirectory
+// Append the lumps in a WAD directory to lumpinfo[]. Returns the index
+//  of the first lump added.
+//
+static int W_AddDirectory(wad_file_t *wad_file, filelump_t *fileinfo, int numfilelumps)
+{
+    lumpindex_t i;
+    int         startlump;
+    filelump_t  *filerover;
+    lumpinfo_t  *filelumps;
+
+    // Increase size of numlumps array to accommodate the new file.
+    filelumps = calloc(numfilelumps, sizeof(lumpinfo_t));
+    if (!filelumps)
+        I_Error("Failed to allocate array for lumps from new file.");
+
+    startlump = numlumps;
+    numlumps += numfilelumps;
+    lumpinfo = Z_Realloc(lumpinfo, numlumps * sizeof(lumpinfo_t *));
+    if (!lumpinfo)
+        I_Error("Failed to increase lumpinfo[] array size.");
+
+    filerover = fileinfo;
+
+    for (i = startlump; i < numlumps; ++i)
+    {
+        lumpinfo_t      *lump_p = &filelumps[i - startlump];
+
+        lump_p->wad_file = wad_file;
+        lump_p->position = LONG(filerover->filepos);
+        lump_p->size = LONG(filerover->size);
+        lump_p->cache = NULL;
+        strncpy(lump_p->name, filerover->name, 8);
+        lumpinfo[i] = lump_p;
+
+        ++filerover;
+    }
+
+    if (lumphash)
+    {
+        Z_Free(lumphash);
+        lumphash = NULL;
+    }
+
+    return startlump;
+}
+
 //
 // W_AddFile
 // All files are optional, but at least one file must be
@@ -128,11 +155,8 @@ unsigned int W_LumpNameHash(const char *s)
 wad_file_t *W_AddFile(char *filename, dboolean automatic)
 {
     wadinfo_t   header;
-    lumpindex_t i;
     int         startlump;
     filelump_t  *fileinfo;
-    filelump_t  *filerover;
-    lumpinfo_t  *filelumps;
     int         numfilelumps;
 
     // open the file and add to directory
@@ -181,48 +205,52 @@ wad_file_t *W_AddFile(char *filename, dboolean automatic)
         length = header.numlumps * sizeof(filelump_t);
         fileinfo = Z_Malloc(length, PU_STATIC, NULL);
 
+        W_Prefetch(wad_file, header.infotableofs, length);
         W_Read(wad_file, header.infotableofs, fileinfo, length);
         numfilelumps = header.numlumps;
     }
 
-    // Increase size of numlumps array to accommodate the new file.
-    filelumps = calloc(numfilelumps, sizeof(lumpinfo_t));
-    if (!filelumps)
-        I_Error("Failed to allocate array for lumps from new file.");
+    startlump = W_AddDirectory(wad_file, fileinfo, numfilelumps);
 
-    startlump = numlumps;
-    numlumps += numfilelumps;
-    lumpinfo = Z_Realloc(lumpinfo, numlumps * sizeof(lumpinfo_t *));
-    if (!lumpinfo)
-        I_Error("Failed to increase lumpinfo[] array size.");
+    Z_Free(fileinfo);
 
-    filerover = fileinfo;
+    C_Output("%s %s lump%s from %.4s file <b>%s</b>.", (automatic ? "Automatically added" :
+        "Added"), commify(numlumps - startlump), (numlumps - startlump == 1 ? "" : "s"),
+        header.identification, filename);
 
-    for (i = startlump; i < numlumps; ++i)
-    {
-        lumpinfo_t      *lump_p = &filelumps[i - startlump];
+    return wad_file;
+}
 
-        lump_p->wad_file = wad_file;
-        lump_p->position = LONG(filerover->filepos);
-        lump_p->size = LONG(filerover->size);
-        lump_p->cache = NULL;
-        strncpy(lump_p->name, filerover->name, 8);
-        lumpinfo[i] = lump_p;
+//
+// W_AddMemoryFile
+// Add a complete PWAD that has been built in memory, such as a generated
+//  map. Its lumps take precedence over those already loaded.
+//
+wad_file_t *W_AddMemoryFile(char *name, void *data, unsigned int length)
+{
+    wadinfo_t   header;
+    int         startlump;
+    filelump_t  *fileinfo;
+    wad_file_t  *wad_file = W_OpenMemory(data, length);
 
-        ++filerover;
-    }
+    M_StringCopy(wad_file->path, name, sizeof(wad_file->path));
+    wad_file->freedoom = false;
+    wad_file->type = PWAD;
+
+    W_Read(wad_file, 0, &header, sizeof(header));
+    header.numlumps = LONG(header.numlumps);
+    header.infotableofs = LONG(header.infotableofs);
+    fileinfo = Z_Malloc(header.numlumps * sizeof(filelump_t), PU_STATIC, NULL);
+    W_Read(wad_file, header.infotableofs, fileinfo, header.numlumps * sizeof(filelump_t));
+
+    startlump = W_AddDirectory(wad_file, fileinfo, header.numlumps);
 
     Z_Free(fileinfo);
 
-    if (lumphash)
-    {
-        Z_Free(lumphash);
-        lumphash = NULL;
-    }
+    W_GenerateHashTable();
 
-    C_Output("%s %s lump%s from %.4s file <b>%s</b>.", (automatic ? "Automatically added" :
-        "Added"), commify(numlumps - startlump), (numlumps - startlump == 1 ? "" : "s"),
-        header.identification, filename);
+    C_Output("Added %s lump%s from generated file <b>%s</b>.", commify(numlumps - startlump),
+        (numlumps - startlump == 1 ? "" : "s"), name);
 
     return wad_file;
 }
@@ -508,6 +536,13 @@ void W_ReadLump(lumpindex_t lump, void *dest)
 // PU_STATIC, it should be released back using W_ReleaseLumpNum
 // when no longer needed (do not use Z_ChangeTag).
 //
+// Lumps in a mapped WAD aren't copied into the zone at all. A pointer into
+// the mapping is returned instead, whatever the tag, and stays valid until
+// the WAD is closed. The mapping is private, so a lump can still be changed
+// in place. Lumps that start at an offset that isn't a multiple of
+// LUMPALIGNMENT are still copied, since callers cast the result straight to
+// structures of shorts and ints.
+//
 void *W_CacheLumpNum(lumpindex_t lumpnum, int tag)
 {
     byte        *result;
@@ -518,16 +553,25 @@ void *W_CacheLumpNum(lumpindex_t lumpnum, int tag)
 
     lump = lumpinfo[lumpnum];
 
-    if (lump->cache)
+    if (W_IsMappedLump(lumpnum))
+        result = lump->wad_file->mapped + lump->position;
+    else if (lump->cache)
     {
-        // Already cached, so just switch the zone tag.
+        // Already cached. Only ever raise the zone tag, so that a lump held
+        // as PU_STATIC isn't made purgeable by someone else asking for it as
+        // PU_CACHE. W_ReleaseLumpNum lowers it again.
         result = (byte *)lump->cache;
-        Z_ChangeTag(lump->cache, tag);
+        if (tag < Z_GetTag(lump->cache))
+            Z_ChangeTag(lump->cache, tag);
+        Z_Touch(lump->cache);
+        ++zonecachehits;
     }
     else
     {
         // Not yet loaded, so load it now
+        ++zonecachemisses;
         lump->cache = Z_Malloc(W_LumpLength(lumpnum), tag, &lump->cache);
+        Z_ChangeOwner(lump->cache, ZO_LUMP);
         W_ReadLump(lumpnum, lump->cache);
         result = (byte *)lump->cache;
     }
@@ -535,6 +579,35 @@ void *W_CacheLumpNum(lumpindex_t lumpnum, int tag)
     return result;
 }
 
+//
+// W_IsMappedLump
+// Returns true if the lump is used in place from a mapped WAD, in which
+// case it isn't in the zone, and mustn't be passed to any Z_ function.
+//
+dboolean W_IsMappedLump(lumpindex_t lumpnum)
+{
+    lumpinfo_t  *lump = lumpinfo[lumpnum];
+    wad_file_t  *wad = lump->wad_file;
+
+    return (wad->mapped && lump->position >= 0 && lump->size >= 0
+        && !(lump->position & (LUMPALIGNMENT - 1))
+        && (unsigned int)lump->position + lump->size <= wad->length);
+}
+
+//
+// W_PrefetchLumps
+// Hints that a run of lumps, such as those of a map, are about to be read.
+//
+void W_PrefetchLumps(lumpindex_t lumpnum, int count)
+{
+    for (; count > 0 && lumpnum < numlumps; ++lumpnum, --count)
+    {
+        lumpinfo_t      *lump = lumpinfo[lumpnum];
+
+        W_Prefetch(lump->wad_file, lump->position, lump->size);
+    }
+}
+
 //
 // W_CacheLumpName
 //
@@ -54,6 +54,30 @@
 #define IWAD 1
 #define PWAD 2
 
+#if defined(_MSC_VER)
+#pragma pack(push)
+#pragma pack(1)
+#endif
+
+typedef struct
+{
+    // Should be "IWAD" or "PWAD".
+    char        identification[4];
+    int         numlumps;
+    int         infotableofs;
+} PACKEDATTR wadinfo_t;
+
+typedef struct
+{
+    int         filepos;
+    int         size;
+    char        name[8];
+} PACKEDATTR filelump_t;
+
+#if defined(_MSC_VER)
+#pragma pack(pop)
+#endif
+
 typedef struct lumpinfo_s lumpinfo_t;
 typedef int lumpindex_t;
 
@@ -73,6 +97,7 @@ extern lumpinfo_t       **lumpinfo;
 extern int              numlumps;
 
 wad_file_t *W_AddFile(char *filename, dboolean automatic);
+wad_file_t *W_AddMemoryFile(char *name, void *data, unsigned int length);
 int W_WadType(char *filename);
 
 lumpindex_t W_CheckNumForName(char *name);
@@ -86,6 +111,9 @@ int W_CheckMultipleLumps(char *name);
 int W_LumpLength(lumpindex_t lump);
 void W_ReadLump(lumpindex_t lump, void *dest);
 
+dboolean W_IsMappedLump(lumpindex_t lump);
+void W_PrefetchLumps(lumpindex_t lump, int count);
+
 void *W_CacheLumpNum(lumpindex_t lump, int tag);
 void *W_CacheLumpName(char *name, int tag);
 
@@ -36,7 +36,11 @@
 ========================================================================
 */
 
+#include "c_console.h"
 #include "i_system.h"
+#include "i_timer.h"
+#include "m_config.h"
+#include "m_misc.h"
 #include "z_zone.h"
 
 // Minimum chunk size at which blocks are allocated
@@ -49,6 +53,9 @@ typedef struct memblock
     size_t              size;
     void                **user;
     unsigned char       tag;
+    unsigned char       owner;
+    unsigned char       arena;
+    zonepool_t          *pool;
 } memblock_t;
 
 // size of block header
@@ -58,6 +65,251 @@ static const size_t     HEADER_SIZE = (sizeof(memblock_t) + CHUNK_SIZE - 1) & ~(
 
 static memblock_t       *blockbytag[PU_MAX];
 
+// running totals and high-water marks of the blocks in the zone, by tag and
+// by owner, including their headers
+zonestats_t             zonetagstats[PU_MAX];
+zonestats_t             zoneownerstats[NUMZONEOWNERS];
+zonestats_t             zonetotalstats;
+
+// buffers grown with Z_Realloc live outside the zone, so their sizes are
+// remembered separately, in an open-addressed table keyed by address that
+// grows as needed
+typedef struct
+{
+    void        *ptr;
+    size_t      size;
+} reallocblock_t;
+
+static reallocblock_t   *reallocblocks;
+static unsigned int     reallocblocksmask;
+static unsigned int     numreallocblocks;
+zonestats_t             zonereallocstats;
+
+// Blocks tagged PU_LEVEL or PU_LEVSPEC without a user are bump-allocated from
+// large chunks, all of which are released at once when the level ends.
+// Smaller blocks freed before then are kept in free lists by size so they can
+// be reused.
+#define ARENA_CHUNK_SIZE        (1024 * 1024)
+#define ARENA_FREELISTS         64
+#define ARENA_SPARECHUNKS       8
+
+// number of blocks in each slab of a pool
+#define POOL_SLABBLOCKS         64
+
+typedef struct arenachunk_s
+{
+    struct arenachunk_s *next;
+    size_t              size;
+    size_t              used;
+} arenachunk_t;
+
+static const size_t     ARENA_HEADER_SIZE = (sizeof(arenachunk_t) + CHUNK_SIZE - 1)
+                            & ~(CHUNK_SIZE - 1);
+
+static arenachunk_t     *arenachunks;
+static arenachunk_t     *sparearenachunks;
+static int              numsparearenachunks;
+static memblock_t       *arenafreeblocks[ARENA_FREELISTS];
+static zonepool_t       *zonepools;
+
+// the part of zonetagstats and zoneownerstats that is in the arena
+static zonestats_t      arenatagstats[PU_MAX];
+static zonestats_t      arenaownerstats[NUMZONEOWNERS];
+
+// chunks allocated for the arena
+zonestats_t             zonearenastats;
+
+char *zonetagnames[PU_MAX] =
+{
+    "Free",
+    "Static",
+    "Level",
+    "Level specials",
+    "Cache"
+};
+
+char *zoneownernames[NUMZONEOWNERS] =
+{
+    "Other",
+    "Lumps",
+    "Composite textures",
+    "Patches",
+    "Level geometry",
+    "Thinkers",
+    "Blood splats",
+    "Sounds"
+};
+
+// tics between each line written by Z_LogStats, or 0 for none
+int                     zonelogtics;
+
+// the most memory, in megabytes, that PU_CACHE blocks may use, or 0 for no
+// limit. The PU_CACHE list is kept in least recently used order, so blocks
+// are evicted from its head, oldest first.
+int                     cachesize = cachesize_default;
+
+size_t                  zonecachehits;
+size_t                  zonecachemisses;
+size_t                  zonecacheevictions;
+
+static void Z_AddStats(zonestats_t *stats, size_t size)
+{
+    stats->bytes += size;
+    if (++stats->blocks > stats->maxblocks)
+        stats->maxblocks = stats->blocks;
+    if (stats->bytes > stats->maxbytes)
+        stats->maxbytes = stats->bytes;
+}
+
+static void Z_RemoveStats(zonestats_t *stats, size_t size)
+{
+    stats->bytes -= size;
+    --stats->blocks;
+}
+
+//
+// Z_ArenaAlloc
+// Returns a block of the given size, including its header, from the arena.
+//
+static memblock_t *Z_ArenaAlloc(size_t size)
+{
+    size_t          index = (size - HEADER_SIZE) / CHUNK_SIZE;
+    arenachunk_t    *chunk = arenachunks;
+    memblock_t      *block;
+
+    // reuse a block of the same size freed earlier in the level
+    if (index < ARENA_FREELISTS && (block = arenafreeblocks[index]))
+    {
+        arenafreeblocks[index] = block->next;
+        return block;
+    }
+
+    if (!chunk || chunk->used + size > chunk->size)
+    {
+        if (size > ARENA_CHUNK_SIZE / 4)
+        {
+            // large blocks get a chunk of their own so the current chunk isn't wasted
+            if (!(chunk = malloc(ARENA_HEADER_SIZE + size)))
+                return NULL;
+
+            chunk->size = size;
+            chunk->used = size;
+            Z_AddStats(&zonearenastats, ARENA_HEADER_SIZE + size);
+
+            if (arenachunks)
+            {
+                chunk->next = arenachunks->next;
+                arenachunks->next = chunk;
+            }
+            else
+            {
+                chunk->next = NULL;
+                arenachunks = chunk;
+            }
+
+            return (memblock_t *)((char *)chunk + ARENA_HEADER_SIZE);
+        }
+
+        if ((chunk = sparearenachunks))
+        {
+            sparearenachunks = chunk->next;
+            --numsparearenachunks;
+        }
+        else if (!(chunk = malloc(ARENA_HEADER_SIZE + ARENA_CHUNK_SIZE)))
+            return NULL;
+        else
+        {
+            chunk->size = ARENA_CHUNK_SIZE;
+            Z_AddStats(&zonearenastats, ARENA_HEADER_SIZE + ARENA_CHUNK_SIZE);
+        }
+
+        chunk->used = 0;
+        chunk->next = arenachunks;
+        arenachunks = chunk;
+    }
+
+    block = (memblock_t *)((char *)chunk + ARENA_HEADER_SIZE + chunk->used);
+    chunk->used += size;
+    return block;
+}
+
+//
+// Z_ArenaFree
+// Called when a block in the arena is freed before the level ends.
+//
+static void Z_ArenaFree(memblock_t *block)
+{
+    size_t  index = block->size / CHUNK_SIZE;
+
+    if (index < ARENA_FREELISTS)
+    {
+        block->next = arenafreeblocks[index];
+        arenafreeblocks[index] = block;
+    }
+}
+
+//
+// Z_FreeArena
+// Releases every block in the arena at once.
+//
+static void Z_FreeArena(void)
+{
+    int         i;
+    zonepool_t  *pool;
+
+    while (arenachunks)
+    {
+        arenachunk_t    *next = arenachunks->next;
+
+        // keep some chunks for the next level
+        if (arenachunks->size == ARENA_CHUNK_SIZE && numsparearenachunks < ARENA_SPARECHUNKS)
+        {
+            arenachunks->next = sparearenachunks;
+            sparearenachunks = arenachunks;
+            ++numsparearenachunks;
+        }
+        else
+        {
+            Z_RemoveStats(&zonearenastats, ARENA_HEADER_SIZE + arenachunks->size);
+            free(arenachunks);
+        }
+
+        arenachunks = next;
+    }
+
+    memset(arenafreeblocks, 0, sizeof(arenafreeblocks));
+
+    for (pool = zonepools; pool; pool = pool->next)
+        pool->freeblocks = NULL;
+
+    for (i = 0; i < PU_MAX; ++i)
+    {
+        zonetagstats[i].blocks -= arenatagstats[i].blocks;
+        zonetagstats[i].bytes -= arenatagstats[i].bytes;
+        zonetotalstats.blocks -= arenatagstats[i].blocks;
+        zonetotalstats.bytes -= arenatagstats[i].bytes;
+    }
+
+    for (i = 0; i < NUMZONEOWNERS; ++i)
+    {
+        zoneownerstats[i].blocks -= arenaownerstats[i].blocks;
+        zoneownerstats[i].bytes -= arenaownerstats[i].bytes;
+    }
+
+    memset(arenatagstats, 0, sizeof(arenatagstats));
+    memset(arenaownerstats, 0, sizeof(arenaownerstats));
+}
+
+//
+// Z_FreeOldestCache
+// Frees the least recently used PU_CACHE block.
+//
+static void Z_FreeOldestCache(void)
+{
+    Z_Free((char *)blockbytag[PU_CACHE] + HEADER_SIZE);
+    ++zonecacheevictions;
+}
+
 //
 // Z_Malloc
 // You can pass a NULL user if the tag is < PU_PURGELEVEL.
@@ -79,28 +331,55 @@ void *Z_Malloc(size_t size, int32_t tag, void **user)
 
     size = (size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1); // round to chunk size
 
-    while (!(block = malloc(size + HEADER_SIZE)))
+    if ((tag == PU_LEVEL || tag == PU_LEVSPEC) && !user)
     {
-        if (!blockbytag[PU_CACHE])
-            I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
-        Z_FreeTags(PU_CACHE, PU_CACHE);
-    }
+        while (!(block = Z_ArenaAlloc(size + HEADER_SIZE)))
+        {
+            if (!blockbytag[PU_CACHE])
+                I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
+            Z_FreeOldestCache();
+        }
 
-    if (!blockbytag[tag])
-    {
-        blockbytag[tag] = block;
-        block->next = block->prev = block;
+        block->next = block->prev = NULL;
+        block->arena = true;
+        block->pool = NULL;
+
+        Z_AddStats(&arenatagstats[tag], size + HEADER_SIZE);
+        Z_AddStats(&arenaownerstats[ZO_OTHER], size + HEADER_SIZE);
     }
     else
     {
-        blockbytag[tag]->prev->next = block;
-        block->prev = blockbytag[tag]->prev;
-        block->next = blockbytag[tag];
-        blockbytag[tag]->prev = block;
+        while (!(block = malloc(size + HEADER_SIZE)))
+        {
+            if (!blockbytag[PU_CACHE])
+                I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
+            Z_FreeOldestCache();
+        }
+
+        if (!blockbytag[tag])
+        {
+            blockbytag[tag] = block;
+            block->next = block->prev = block;
+        }
+        else
+        {
+            blockbytag[tag]->prev->next = block;
+            block->prev = blockbytag[tag]->prev;
+            block->next = blockbytag[tag];
+            blockbytag[tag]->prev = block;
+        }
+
+        block->arena = false;
+        block->pool = NULL;
     }
 
     block->size = size;
 
+    Z_AddStats(&zonetagstats[tag], size + HEADER_SIZE);
+    Z_AddStats(&zoneownerstats[ZO_OTHER], size + HEADER_SIZE);
+    Z_AddStats(&zonetotalstats, size + HEADER_SIZE);
+
+    block->owner = ZO_OTHER;                            // owner
     block->tag = tag;                                   // tag
     block->user = user;                                 // user
     block = (memblock_t *)((char *)block + HEADER_SIZE);
@@ -115,16 +394,168 @@ void *Z_Calloc(size_t n1, size_t n2, int32_t tag, void **user)
     return ((n1 *= n2) ? memset(Z_Malloc(n1, tag, user), 0, n1) : NULL);
 }
 
+//
+// Z_PoolCalloc
+// Returns a zero-filled block from a pool.
+//
+void *Z_PoolCalloc(zonepool_t *pool)
+{
+    size_t      size = (pool->size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1);
+    memblock_t  *block;
+
+    if (!pool->registered)
+    {
+        pool->next = zonepools;
+        zonepools = pool;
+        pool->registered = true;
+    }
+
+    if (!(block = pool->freeblocks))
+    {
+        char    *slab;
+        int     i;
+
+        while (!(slab = (char *)Z_ArenaAlloc((size + HEADER_SIZE) * POOL_SLABBLOCKS)))
+        {
+            if (!blockbytag[PU_CACHE])
+                I_Error("Z_PoolCalloc: Failure trying to allocate %lu bytes",
+                    (unsigned long)((size + HEADER_SIZE) * POOL_SLABBLOCKS));
+            Z_FreeOldestCache();
+        }
+
+        // link the blocks so they're used in order
+        for (i = POOL_SLABBLOCKS - 1; i >= 0; --i)
+        {
+            block = (memblock_t *)(slab + i * (size + HEADER_SIZE));
+            block->next = pool->freeblocks;
+            pool->freeblocks = block;
+        }
+    }
+
+    pool->freeblocks = block->next;
+
+    block->next = block->prev = NULL;
+    block->size = size;
+    block->user = NULL;
+    block->tag = (unsigned char)pool->tag;
+    block->owner = (unsigned char)pool->owner;
+    block->arena = true;
+    block->pool = pool;
+
+    Z_AddStats(&zonetagstats[pool->tag], size + HEADER_SIZE);
+    Z_AddStats(&zoneownerstats[pool->owner], size + HEADER_SIZE);
+    Z_AddStats(&zonetotalstats, size + HEADER_SIZE);
+    Z_AddStats(&arenatagstats[pool->tag], size + HEADER_SIZE);
+    Z_AddStats(&arenaownerstats[pool->owner], size + HEADER_SIZE);
+
+    return memset((char *)block + HEADER_SIZE, 0, size);
+}
+
+static unsigned int Z_ReallocSlot(void *ptr)
+{
+    return ((unsigned int)(((uint64_t)(uintptr_t)ptr * 0x9E3779B97F4A7C15ull) >> 32)
+        & reallocblocksmask);
+}
+
+static reallocblock_t *Z_FindRealloc(void *ptr)
+{
+    unsigned int    i;
+
+    if (!reallocblocks)
+        return NULL;
+
+    for (i = Z_ReallocSlot(ptr); reallocblocks[i].ptr; i = (i + 1) & reallocblocksmask)
+        if (reallocblocks[i].ptr == ptr)
+            return &reallocblocks[i];
+
+    return NULL;
+}
+
+static void Z_AddRealloc(void *ptr, size_t size)
+{
+    unsigned int    i;
+
+    // keep the table at most half full
+    if ((numreallocblocks + 1) * 2 > (reallocblocks ? reallocblocksmask + 1 : 0))
+    {
+        reallocblock_t  *oldblocks = reallocblocks;
+        unsigned int    oldsize = (oldblocks ? reallocblocksmask + 1 : 0);
+        unsigned int    newsize = (oldsize ? oldsize * 2 : 64);
+
+        if (!(reallocblocks = calloc(newsize, sizeof(*reallocblocks))))
+            I_Error("Z_Realloc: Failure trying to allocate %lu bytes",
+                (unsigned long)(newsize * sizeof(*reallocblocks)));
+
+        reallocblocksmask = newsize - 1;
+
+        for (i = 0; i < oldsize; ++i)
+            if (oldblocks[i].ptr)
+            {
+                unsigned int    j = Z_ReallocSlot(oldblocks[i].ptr);
+
+                while (reallocblocks[j].ptr)
+                    j = (j + 1) & reallocblocksmask;
+
+                reallocblocks[j] = oldblocks[i];
+            }
+
+        free(oldblocks);
+    }
+
+    for (i = Z_ReallocSlot(ptr); reallocblocks[i].ptr; i = (i + 1) & reallocblocksmask);
+
+    reallocblocks[i].ptr = ptr;
+    reallocblocks[i].size = size;
+    ++numreallocblocks;
+    Z_AddStats(&zonereallocstats, size);
+}
+
+static void Z_RemoveRealloc(reallocblock_t *rb)
+{
+    unsigned int    i = (unsigned int)(rb - reallocblocks);
+    unsigned int    j = i;
+
+    Z_RemoveStats(&zonereallocstats, rb->size);
+    --numreallocblocks;
+
+    // shift back any later entries in the same run that would no longer be
+    // found once this slot is empty
+    while (reallocblocks[j = (j + 1) & reallocblocksmask].ptr)
+    {
+        unsigned int    k = Z_ReallocSlot(reallocblocks[j].ptr);
+
+        if (i <= j ? (k <= i || k > j) : (k <= i && k > j))
+        {
+            reallocblocks[i] = reallocblocks[j];
+            i = j;
+        }
+    }
+
+    reallocblocks[i].ptr = NULL;
+}
+
+//
+// Z_Realloc
+// Unlike the other functions here, this works on memory outside the zone.
+// Passing a size of 0 frees ptr.
+//
 void *Z_Realloc(void *ptr, size_t size)
 {
-    void        *newp = realloc(ptr, size);
+    void                *newp = NULL;
+    reallocblock_t      *rb;
 
-    if (!newp && size)
+    if (!size)
+        free(ptr);
+    else if (!(newp = realloc(ptr, size)))
         I_Error("Z_Realloc: Failure trying to reallocate %lu bytes", (unsigned long)size);
-    else
-        ptr = newp;
 
-    return ptr;
+    if (ptr && (rb = Z_FindRealloc(ptr)))
+        Z_RemoveRealloc(rb);
+
+    if (newp)
+        Z_AddRealloc(newp, size);
+
+    return newp;
 }
 
 void Z_Free(void *ptr)
@@ -137,6 +568,26 @@ void Z_Free(void *ptr)
     if (block->user)                                    // Nullify user if one exists
         *block->user = NULL;
 
+    Z_RemoveStats(&zonetagstats[block->tag], block->size + HEADER_SIZE);
+    Z_RemoveStats(&zoneownerstats[block->owner], block->size + HEADER_SIZE);
+    Z_RemoveStats(&zonetotalstats, block->size + HEADER_SIZE);
+
+    if (block->arena)
+    {
+        Z_RemoveStats(&arenatagstats[block->tag], block->size + HEADER_SIZE);
+        Z_RemoveStats(&arenaownerstats[block->owner], block->size + HEADER_SIZE);
+
+        if (block->pool)
+        {
+            block->next = block->pool->freeblocks;
+            block->pool->freeblocks = block;
+        }
+        else
+            Z_ArenaFree(block);
+
+        return;
+    }
+
     if (block == block->next)
         blockbytag[block->tag] = NULL;
     else if (blockbytag[block->tag] == block)
@@ -154,6 +605,9 @@ void Z_FreeTags(int32_t lowtag, int32_t hightag)
     if (hightag > PU_CACHE)
         hightag = PU_CACHE;
 
+    if (lowtag <= PU_LEVEL && hightag >= PU_LEVSPEC)
+        Z_FreeArena();
+
     for (; lowtag <= hightag; ++lowtag)
     {
         memblock_t      *block;
@@ -187,6 +641,19 @@ void Z_ChangeTag(void *ptr, int32_t tag)
     if (tag == block->tag)
         return;
 
+    if (block->arena)
+    {
+        if (tag != PU_LEVEL && tag != PU_LEVSPEC)
+            I_Error("Z_ChangeTag: A level block can't be changed to tag %i", tag);
+
+        Z_RemoveStats(&arenatagstats[block->tag], block->size + HEADER_SIZE);
+        Z_AddStats(&arenatagstats[tag], block->size + HEADER_SIZE);
+        Z_RemoveStats(&zonetagstats[block->tag], block->size + HEADER_SIZE);
+        Z_AddStats(&zonetagstats[tag], block->size + HEADER_SIZE);
+        block->tag = tag;
+        return;
+    }
+
     if (block == block->next)
         blockbytag[block->tag] = NULL;
     else if (blockbytag[block->tag] == block)
@@ -207,5 +674,102 @@ void Z_ChangeTag(void *ptr, int32_t tag)
         blockbytag[tag]->prev = block;
     }
 
+    Z_RemoveStats(&zonetagstats[block->tag], block->size + HEADER_SIZE);
+    Z_AddStats(&zonetagstats[tag], block->size + HEADER_SIZE);
+
     block->tag = tag;
 }
+
+//
+// Z_GetTag
+//
+int32_t Z_GetTag(void *ptr)
+{
+    return (ptr ? ((memblock_t *)((char *)ptr - HEADER_SIZE))->tag : PU_FREE);
+}
+
+//
+// Z_Touch
+// Marks a PU_CACHE block as the most recently used by moving it to the end of
+// the list.
+//
+void Z_Touch(void *ptr)
+{
+    memblock_t  *block = (memblock_t *)((char *)ptr - HEADER_SIZE);
+    memblock_t  *head;
+
+    if (!ptr || block->tag != PU_CACHE)
+        return;
+
+    head = blockbytag[PU_CACHE];
+
+    if (block == head)
+        blockbytag[PU_CACHE] = block->next;
+    else if (block != head->prev)
+    {
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        head->prev->next = block;
+        block->prev = head->prev;
+        block->next = head;
+        head->prev = block;
+    }
+}
+
+//
+// Z_TrimCache
+// Called once a frame to evict the least recently used blocks until the cache
+// is back within its budget. Anything that keeps a lump across frames must
+// therefore hold it as PU_STATIC, or fetch it again each time it's used.
+//
+void Z_TrimCache(void)
+{
+    size_t  budget = (size_t)cachesize * 1024 * 1024;
+
+    if (!cachesize)
+        return;
+
+    while (blockbytag[PU_CACHE] && zonetagstats[PU_CACHE].bytes > budget)
+        Z_FreeOldestCache();
+}
+
+void Z_ChangeOwner(void *ptr, int owner)
+{
+    memblock_t  *block = (memblock_t *)((char *)ptr - HEADER_SIZE);
+
+    if (!ptr || owner == block->owner)
+        return;
+
+    Z_RemoveStats(&zoneownerstats[block->owner], block->size + HEADER_SIZE);
+    Z_AddStats(&zoneownerstats[owner], block->size + HEADER_SIZE);
+
+    if (block->arena)
+    {
+        Z_RemoveStats(&arenaownerstats[block->owner], block->size + HEADER_SIZE);
+        Z_AddStats(&arenaownerstats[owner], block->size + HEADER_SIZE);
+    }
+
+    block->owner = owner;
+}
+
+//
+// Z_LogStats
+// Called every frame to periodically show how much memory is being used.
+//
+void Z_LogStats(void)
+{
+    static int  lasttic;
+    int         tic;
+
+    if (!zonelogtics || (tic = I_GetTime()) - lasttic < zonelogtics)
+        return;
+
+    lasttic = tic;
+
+    C_Output("Zone: <b>%s</b> in <b>%s</b> blocks (<b>%s</b> static, <b>%s</b> level, "
+        "<b>%s</b> cache). Outside zone: <b>%s</b>.",
+        convertsize((int)zonetotalstats.bytes), commify(zonetotalstats.blocks),
+        convertsize((int)zonetagstats[PU_STATIC].bytes),
+        convertsize((int)(zonetagstats[PU_LEVEL].bytes + zonetagstats[PU_LEVSPEC].bytes)),
+        convertsize((int)zonetagstats[PU_CACHE].bytes), convertsize((int)zonereallocstats.bytes));
+}
@@ -64,11 +64,74 @@ enum
 
 #define PU_PURGELEVEL    PU_CACHE    // First purgeable tag's level
 
+//
+// ZO - owner categories, used only for accounting.
+//
+enum
+{
+    ZO_OTHER,
+    ZO_LUMP,
+    ZO_TEXTURE,
+    ZO_PATCH,
+    ZO_LEVEL,
+    ZO_THINKER,
+    ZO_BLOODSPLAT,
+    ZO_SOUND,
+    NUMZONEOWNERS
+};
+
+typedef struct
+{
+    size_t      blocks;
+    size_t      bytes;
+    size_t      maxblocks;
+    size_t      maxbytes;
+} zonestats_t;
+
+//
+// Pools of blocks of one size, such as a type of thinker, that are allocated
+// from the level arena a slab at a time so they are close together in
+// memory. Freed blocks are reused before another slab is allocated.
+//
+typedef struct zonepool_s
+{
+    size_t              size;
+    int32_t             tag;
+    int                 owner;
+    void                *freeblocks;
+    struct zonepool_s   *next;
+    dboolean            registered;
+} zonepool_t;
+
+#define ZONEPOOL(type, tag, owner)      { sizeof(type), tag, owner, NULL, NULL, false }
+
+extern zonestats_t      zonetagstats[PU_MAX];
+extern zonestats_t      zoneownerstats[NUMZONEOWNERS];
+extern zonestats_t      zonetotalstats;
+extern zonestats_t      zonereallocstats;
+extern zonestats_t      zonearenastats;
+
+extern char             *zonetagnames[PU_MAX];
+extern char             *zoneownernames[NUMZONEOWNERS];
+
+extern int              zonelogtics;
+
+extern int              cachesize;
+extern size_t           zonecachehits;
+extern size_t           zonecachemisses;
+extern size_t           zonecacheevictions;
+
 void *Z_Malloc(size_t size, int32_t tag, void **user);
 void *Z_Calloc(size_t n1, size_t n2, int32_t tag, void **user);
+void *Z_PoolCalloc(zonepool_t *pool);
 void *Z_Realloc(void *ptr, size_t size);
 void Z_Free(void *ptr);
 void Z_FreeTags(int32_t lowtag, int32_t hightag);
 void Z_ChangeTag(void *ptr, int32_t tag);
+void Z_ChangeOwner(void *ptr, int owner);
+int32_t Z_GetTag(void *ptr);
+void Z_Touch(void *ptr);
+void Z_TrimCache(void);
+void Z_LogStats(void);
 
 #endif